@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+// include standard library
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/* Minimal headless benchmark harness used by the engine's
+micro-benchmarks. Measures wall time of a function and prints
+the average time of a single operation.
+*/
+namespace Bench{
+    // run a function once and return the elapsed time in nanoseconds
+    template<typename Func>
+    double Measure(Func func){
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // run a function a given amount of times and return the fastest run in nanoseconds
+    template<typename Func>
+    double MeasureBest(int runs, Func func){
+        double best = Measure(func);
+        for(int i = 1; i < runs; i++){
+            double time = Measure(func);
+            best = time < best ? time : best;
+        }
+        return best;
+    }
+
+    // print the result of a benchmark, the time is divided by the amount of operations performed
+    inline void Report(const char* name, std::size_t operations, double nanoseconds){
+        std::printf("%-40s %10zu ops %12.2f ns/op %14.0f ops/s\n", name, operations, nanoseconds / operations, operations / (nanoseconds * 1e-9));
+    }
+
+#if !defined(__GNUC__) && !defined(__clang__)
+    // compilers without GNU inline assembly publish values through this instead
+    inline const void* volatile sink = nullptr;
+#endif
+
+    // keep the compiler from optimizing away a value
+    template<typename T>
+    void DoNotOptimize(T const& value){
+#if defined(__GNUC__) || defined(__clang__)
+        // an empty assembly block that may read the value and any memory
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        sink = &value;
+#endif
+    }
+}
+
+#endif
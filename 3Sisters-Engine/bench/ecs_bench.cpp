@@ -0,0 +1,324 @@
+#include "bench.hpp"
+
+// include standard library
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ecs/ecs.hpp>
+
+/* Measures the cost of the ECS's common operations at different
+entity counts: creating and destroying entities, reserving entities
+from multiple threads, adding and removing
+components, iterating views, updating system membership when many
+systems are registered, and the memory held per entity.
+    @ usage: ecs-bench [storage option], where the storage option is 's' (sparse, default) or 'a' (archetype)
+    @NOTE: the ECS can only be initialized once, so each storage option is measured by a separate run
+*/
+
+//* Memory tracking
+
+// bytes currently allocated through operator new
+static std::atomic<std::size_t> liveBytes{0};
+
+// allocate memory with a header in front that remembers the size and the original allocation
+static void* trackedAllocate(std::size_t size, std::size_t alignment){
+    const std::size_t header = 2 * sizeof(void*);
+    alignment = alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment;
+
+    void* raw = std::malloc(size + header + alignment);
+    if(raw == nullptr){
+        throw std::bad_alloc();
+    }
+
+    std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(raw) + header + alignment - 1) & ~(alignment - 1);
+    reinterpret_cast<std::size_t*>(address)[-1] = size;
+    reinterpret_cast<void**>(address)[-2] = raw;
+
+    liveBytes.fetch_add(size, std::memory_order_relaxed);
+    return reinterpret_cast<void*>(address);
+}
+
+// free memory allocated by trackedAllocate
+static void trackedFree(void* data){
+    if(data == nullptr){
+        return;
+    }
+
+    liveBytes.fetch_sub(static_cast<std::size_t*>(data)[-1], std::memory_order_relaxed);
+    std::free(static_cast<void**>(data)[-2]);
+}
+
+void* operator new(std::size_t size){ return trackedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size){ return trackedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment){ return trackedAllocate(size, (std::size_t)alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment){ return trackedAllocate(size, (std::size_t)alignment); }
+void operator delete(void* data) noexcept{ trackedFree(data); }
+void operator delete[](void* data) noexcept{ trackedFree(data); }
+void operator delete(void* data, std::size_t) noexcept{ trackedFree(data); }
+void operator delete[](void* data, std::size_t) noexcept{ trackedFree(data); }
+void operator delete(void* data, std::align_val_t) noexcept{ trackedFree(data); }
+void operator delete[](void* data, std::align_val_t) noexcept{ trackedFree(data); }
+void operator delete(void* data, std::size_t, std::align_val_t) noexcept{ trackedFree(data); }
+void operator delete[](void* data, std::size_t, std::align_val_t) noexcept{ trackedFree(data); }
+
+//* Components and systems used by the benchmarks
+
+struct Position{
+    float x, y;
+};
+
+struct Velocity{
+    float x, y;
+};
+
+struct Health{
+    std::int32_t value;
+};
+
+// distinct components, used to give the benchmark systems different signatures
+template<int N>
+struct Marker{
+    std::uint32_t value;
+};
+
+// distinct systems, only their membership is measured
+template<int N>
+class BenchSystem : public System{};
+
+// amount of systems registered for the signature change benchmark
+const int systemCount = 64;
+
+// amount of times each benchmark is repeated, the reported time is the average
+const int runs = 3;
+
+// register the marker components
+template<int... Ns>
+void registerMarkers(std::integer_sequence<int, Ns...>){
+    (ECS::RegisterComponent<Marker<Ns>>(), ...);
+}
+
+/* register a benchmark system, every system needs a Position,
+odd systems also need a Velocity and half of them need a marker
+*/
+template<int N>
+void registerSystem(){
+    ECS::RegisterSystem<BenchSystem<N>>();
+
+    Signature signature = ECS::GetComponentSignature<Position>();
+    if(N % 2 == 1){
+        signature |= ECS::GetComponentSignature<Velocity>();
+    }
+    if(N >= systemCount / 2){
+        signature |= ECS::GetComponentSignature<Marker<N % 8>>();
+    }
+    ECS::SetSystemSignature<BenchSystem<N>>(signature);
+}
+
+// register every benchmark system
+template<int... Ns>
+void registerSystems(std::integer_sequence<int, Ns...>){
+    (registerSystem<Ns>(), ...);
+}
+
+//* Benchmarks
+
+// memory held by the ECS per entity with two components, includes capacity kept by earlier runs
+void benchMemory(std::size_t count, std::size_t baseline){
+    std::vector<Entity> entities = ECS::CreateEntities(count, Position{}, Velocity{});
+
+    // the vector of handles isn't part of the ECS
+    std::size_t held = liveBytes.load() - baseline - entities.capacity() * sizeof(Entity);
+    std::printf("%-40s %10zu ents %12.2f bytes/entity\n", "memory (Position, Velocity)", count, (double)held / count);
+
+    ECS::DestroyEntities(entities);
+}
+
+// create and destroy entities one at a time and in batches
+void benchChurn(std::size_t count){
+    std::vector<Entity> entities(count);
+
+    double createTime = 0.0;
+    double destroyTime = 0.0;
+    double batchCreateTime = 0.0;
+    double batchDestroyTime = 0.0;
+    for(int run = 0; run < runs; run++){
+        createTime += Bench::Measure([&](){
+            for(Entity& entity : entities){
+                entity = ECS::CreateEntity();
+            }
+        });
+
+        destroyTime += Bench::Measure([&](){
+            for(Entity entity : entities){
+                ECS::DestroyEntity(entity);
+            }
+        });
+
+        batchCreateTime += Bench::Measure([&](){
+            entities = ECS::CreateEntities(count, Position{}, Velocity{});
+        });
+
+        batchDestroyTime += Bench::Measure([&](){
+            ECS::DestroyEntities(entities);
+        });
+    }
+
+    Bench::Report("create entity", count, createTime / runs);
+    Bench::Report("destroy entity", count, destroyTime / runs);
+    Bench::Report("create entities (batch, 2 comps)", count, batchCreateTime / runs);
+    Bench::Report("destroy entities (batch, 2 comps)", count, batchDestroyTime / runs);
+}
+
+// amount of threads reserving entities at once
+const std::size_t reserveThreads = 4;
+
+// reserve entities from multiple threads, then turn them into living entities and destroy them
+void benchReserve(std::size_t count){
+    std::vector<Entity> entities(count);
+    std::size_t share = count / reserveThreads;
+
+    double reserveTime = 0.0;
+    double flushTime = 0.0;
+    for(int run = 0; run < runs; run++){
+        reserveTime += Bench::Measure([&](){
+            std::vector<std::thread> threads;
+            for(std::size_t t = 0; t < reserveThreads; t++){
+                threads.emplace_back([&, t](){
+                    for(std::size_t i = t * share; i < (t + 1) * share; i++){
+                        entities[i] = ECS::ReserveEntity();
+                    }
+                });
+            }
+            for(std::thread& thread : threads){
+                thread.join();
+            }
+        });
+
+        flushTime += Bench::Measure([&](){
+            ECS::FlushReservedEntities();
+        });
+
+        entities.resize(share * reserveThreads);
+        ECS::DestroyEntities(entities);
+    }
+
+    Bench::Report("reserve entity (4 threads)", share * reserveThreads, reserveTime / runs);
+    Bench::Report("flush reserved entities", share * reserveThreads, flushTime / runs);
+}
+
+// add and remove components on existing entities, reported under a given name suffix
+void benchAddRemove(std::size_t count, const char* suffix){
+    std::vector<Entity> entities = ECS::CreateEntities(count, Position{});
+
+    double addTime = 0.0;
+    double removeTime = 0.0;
+    for(int run = 0; run < runs; run++){
+        addTime += Bench::Measure([&](){
+            for(Entity entity : entities){
+                ECS::AddComponent(entity, Velocity{1.0f, 1.0f});
+            }
+        });
+
+        removeTime += Bench::Measure([&](){
+            for(Entity entity : entities){
+                ECS::RemoveComponent<Velocity>(entity);
+            }
+        });
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "add component%s", suffix);
+    Bench::Report(name, count, addTime / runs);
+    std::snprintf(name, sizeof(name), "remove component%s", suffix);
+    Bench::Report(name, count, removeTime / runs);
+
+    ECS::DestroyEntities(entities);
+}
+
+// iterate views of one, two, and three components
+void benchIteration(std::size_t count){
+    std::vector<Entity> entities = ECS::CreateEntities(count, Position{}, Velocity{1.0f, 1.0f});
+
+    // every other entity has a health, so the three component view skips entities
+    for(std::size_t i = 0; i < count; i += 2){
+        ECS::AddComponent(entities[i], Health{100});
+    }
+
+    double singleTime = 0.0;
+    double multiTime = 0.0;
+    double tripleTime = 0.0;
+    for(int run = 0; run < runs; run++){
+        singleTime += Bench::Measure([&](){
+            float sum = 0.0f;
+            ECS::View<Position>().Each([&sum](Entity, Position& position){
+                sum += position.x;
+            });
+            Bench::DoNotOptimize(sum);
+        });
+
+        multiTime += Bench::Measure([&](){
+            ECS::View<Position, Velocity>().Each([](Entity, Position& position, Velocity& velocity){
+                position.x += velocity.x;
+                position.y += velocity.y;
+            });
+        });
+
+        tripleTime += Bench::Measure([&](){
+            ECS::View<Position, Velocity, Health>().Each([](Entity, Position& position, Velocity& velocity, Health& health){
+                position.x += velocity.x * health.value;
+            });
+        });
+    }
+
+    Bench::Report("iterate (Position)", count, singleTime / runs);
+    Bench::Report("iterate (Position, Velocity)", count, multiTime / runs);
+    Bench::Report("iterate (Position, Velocity, Health)", count, tripleTime / runs);
+
+    ECS::DestroyEntities(entities);
+}
+
+int main(int argc, char** argv){
+    char storage = argc > 1 ? argv[1][0] : 's';
+    if(storage != 's' && storage != 'a'){
+        std::printf("usage: ecs-bench [s|a]\n");
+        return 1;
+    }
+
+    ECS::Init('r', storage);
+    ECS::RegisterComponent<Position>();
+    ECS::RegisterComponent<Velocity>();
+    ECS::RegisterComponent<Health>();
+    registerMarkers(std::make_integer_sequence<int, 8>());
+
+    std::printf("=== ECS benchmarks, %s storage ===\n", storage == 'a' ? "archetype" : "sparse");
+
+    const std::size_t counts[] = {1000, 10000, 100000};
+
+    // memory runs first, before the other benchmarks grow the storage
+    std::size_t baseline = liveBytes.load();
+    for(std::size_t count : counts){
+        benchMemory(count, baseline);
+    }
+
+    for(std::size_t count : counts){
+        std::printf("--- %zu entities ---\n", count);
+        benchChurn(count);
+        benchReserve(count);
+        benchAddRemove(count, "");
+        benchIteration(count);
+    }
+
+    // systems can't be unregistered, so the signature change cost with many systems is measured last
+    registerSystems(std::make_integer_sequence<int, systemCount>());
+    std::printf("--- %d systems registered ---\n", systemCount);
+    for(std::size_t count : counts){
+        benchAddRemove(count, " (64 systems)");
+    }
+
+    return 0;
+}
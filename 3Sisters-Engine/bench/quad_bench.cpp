@@ -0,0 +1,137 @@
+#include "bench.hpp"
+
+// include standard library
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// include GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <engine/quad_batch.hpp>
+
+/* Measures how many quads per second the CPU side of the quad
+renderer can build, without an OpenGL context. Compares the previous
+createQuad(), which built three mat4s and multiplied every corner by
+their product, against the direct 2D math it now uses and against
+BuildQuadVertices() used by QuadRenderer::StackQuads().
+*/
+
+// amount of quads per run, matches the size of a single quad batch
+const std::size_t QUAD_COUNT = 10000;
+
+// amount of runs, the fastest one is reported
+const int RUNS = 50;
+
+// default offsets of quad vertex positions and texture coordinates, same as the quad renderer
+const glm::vec4 vertexPositions[4] = {
+    {-0.5f, -0.5f, 0.0f, 1.0f},
+    {0.5f, -0.5f, 0.0f, 1.0f},
+    {0.5f, 0.5f, 0.0f, 1.0f},
+    {-0.5f, 0.5f, 0.0f, 1.0f}};
+const glm::vec2 textureCoordinates[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+
+// raw data of a quad as given to StackQuad()
+struct RawQuad{
+    int texIndex;
+    glm::vec2 position;
+    glm::vec2 size;
+    float rotation;
+    glm::vec4 color;
+};
+
+// previous createQuad(), kept for comparison
+static QuadVertex* buildMatrixQuad(const RawQuad& quad, QuadVertex* output){
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(quad.position, 0.0f))
+    * glm::rotate(glm::mat4(1.0f), glm::radians(quad.rotation), {0.0f, 0.0f, 1.0f})
+    * glm::scale(glm::mat4(1.0f), {quad.size.x, quad.size.y, 0.0f});
+
+    for(int i = 0; i < 4; i++){
+        output->position = transform * vertexPositions[i];
+        output->texCoords = textureCoordinates[i];
+        output->texIndex = quad.texIndex;
+        output->color = quad.color;
+        output++;
+    }
+    return output;
+}
+
+// current createQuad()
+static QuadVertex* buildDirectQuad(const RawQuad& quad, QuadVertex* output){
+    float radians = glm::radians(quad.rotation);
+    float c = std::cos(radians), s = std::sin(radians);
+
+    for(int i = 0; i < 4; i++){
+        float x = vertexPositions[i].x * quad.size.x, y = vertexPositions[i].y * quad.size.y;
+
+        output->position = glm::vec2(c * x - s * y, s * x + c * y) + quad.position * vertexPositions[i].w;
+        output->texCoords = textureCoordinates[i];
+        output->texIndex = quad.texIndex;
+        output->color = quad.color;
+        output++;
+    }
+    return output;
+}
+
+int main(){
+    std::printf("Quad vertex building, %zu quads per run\n", QUAD_COUNT);
+
+    // random quads, colors are multiples of 1/255 so packing them is lossless
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-1000.0f, 1000.0f), size(1.0f, 64.0f), rotation(-180.0f, 180.0f);
+    std::uniform_int_distribution<int> channel(0, 255), texture(0, 31);
+
+    std::vector<RawQuad> quads(QUAD_COUNT);
+    std::vector<QuadInstance> instances(QUAD_COUNT);
+    for(std::size_t i = 0; i < QUAD_COUNT; i++){
+        glm::vec4 color(channel(random) / 255.0f, channel(random) / 255.0f, channel(random) / 255.0f, channel(random) / 255.0f);
+        quads[i] = {texture(random), {position(random), position(random)}, {size(random), size(random)}, rotation(random), color};
+
+        // use the rotation the instance can store, so every path builds the same quad
+        instances[i] = QuadInstance::Create(quads[i].texIndex, quads[i].position, quads[i].size, quads[i].rotation, color);
+        quads[i].rotation = instances[i].rotation / 32767.0f * 180.0f;
+    }
+
+    std::vector<QuadVertex> matrixVertices(QUAD_COUNT * 4), directVertices(QUAD_COUNT * 4), batchVertices(QUAD_COUNT * 4);
+
+    double ns = Bench::MeasureBest(RUNS, [&]{
+        QuadVertex* output = matrixVertices.data();
+        for(const RawQuad& quad : quads){
+            output = buildMatrixQuad(quad, output);
+        }
+        Bench::DoNotOptimize(matrixVertices);
+    });
+    Bench::Report("mat4 transform (previous createQuad)", QUAD_COUNT, ns);
+
+    ns = Bench::MeasureBest(RUNS, [&]{
+        QuadVertex* output = directVertices.data();
+        for(const RawQuad& quad : quads){
+            output = buildDirectQuad(quad, output);
+        }
+        Bench::DoNotOptimize(directVertices);
+    });
+    Bench::Report("direct 2D (createQuad)", QUAD_COUNT, ns);
+
+    ns = Bench::MeasureBest(RUNS, [&]{
+        BuildQuadVertices(instances, batchVertices.data());
+        Bench::DoNotOptimize(batchVertices);
+    });
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    Bench::Report("BuildQuadVertices (SSE2)", QUAD_COUNT, ns);
+#else
+    Bench::Report("BuildQuadVertices (scalar)", QUAD_COUNT, ns);
+#endif
+
+    // check every path built the same corners
+    float directError = 0.0f, batchError = 0.0f;
+    for(std::size_t i = 0; i < QUAD_COUNT * 4; i++){
+        float scale = std::max(1.0f, glm::length(matrixVertices[i].position));
+        directError = std::max(directError, glm::length(directVertices[i].position - matrixVertices[i].position) / scale);
+        batchError = std::max(batchError, glm::length(batchVertices[i].position - matrixVertices[i].position) / scale);
+    }
+    std::printf("max relative corner error: direct %g, batch %g\n", directError, batchError);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "bench.hpp"
+
+// include standard library
+#include <unordered_map>
+#include <vector>
+#include <numeric>
+#include <random>
+#include <algorithm>
+
+#include <ecs/types/component_array.hpp>
+
+/* Compares the sparse set backed ComponentArray against the previous
+implementation, which mapped entities to packed indices through two
+std::unordered_maps. Both store components in a packed array and remove
+with swap-and-pop, only the entity to index mapping differs.
+*/
+
+// component used by the benchmark, matches the size of Transform2D
+struct BenchComponent{
+    float position[2];
+    float rotation;
+    float size[2];
+};
+
+// previous map based component array, kept for comparison
+template<typename T>
+class MapComponentArray{
+    private:
+        std::vector<T> componentArray{};
+        std::unordered_map<Entity, size_t> entityToIndexMap{};
+        std::unordered_map<size_t, Entity> indexToEntityMap{};
+        size_t size{};
+
+    public:
+        void InsertData(Entity entity, T component){
+            size_t newIndex = size;
+            entityToIndexMap[entity] = newIndex;
+            indexToEntityMap[newIndex] = entity;
+            if(newIndex >= componentArray.size()){
+                componentArray.push_back(component);
+            }else{
+                componentArray[newIndex] = component;
+            }
+            ++size;
+        }
+
+        void RemoveData(Entity entity){
+            size_t indexOfRemovedEntity = entityToIndexMap[entity];
+            size_t indexOfLastElement = size - 1;
+            componentArray[indexOfRemovedEntity] = componentArray[indexOfLastElement];
+
+            Entity entityOfLastElement = indexToEntityMap[indexOfLastElement];
+            entityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
+            indexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+
+            entityToIndexMap.erase(entity);
+            indexToEntityMap.erase(indexOfLastElement);
+
+            --size;
+        }
+
+        T& GetData(Entity entity){
+            return componentArray[entityToIndexMap[entity]];
+        }
+};
+
+// run insert, lookup, and remove benchmarks on a component array type
+template<typename Array>
+void runBenchmarks(const char* name, std::size_t count){
+    // shuffled entity IDs to avoid measuring only sequential access
+    std::vector<Entity> entities(count);
+    std::iota(entities.begin(), entities.end(), 0);
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+
+    char label[64];
+
+    // accumulated time of each operation over all runs
+    double insertTime = 0.0;
+    double lookupTime = 0.0;
+    double removeTime = 0.0;
+    const int runs = 3;
+    for(int run = 0; run < runs; run++){
+        Array array;
+
+        insertTime += Bench::Measure([&](){
+            for(Entity entity : entities){
+                array.InsertData(entity, BenchComponent{{(float)entity, 0.0f}, 0.0f, {1.0f, 1.0f}});
+            }
+        });
+
+        lookupTime += Bench::Measure([&](){
+            float sum = 0.0f;
+            for(Entity entity : entities){
+                sum += array.GetData(entity).position[0];
+            }
+            Bench::DoNotOptimize(sum);
+        });
+
+        removeTime += Bench::Measure([&](){
+            for(Entity entity : entities){
+                array.RemoveData(entity);
+            }
+        });
+    }
+
+    std::snprintf(label, sizeof(label), "%s insert", name);
+    Bench::Report(label, count, insertTime / runs);
+    std::snprintf(label, sizeof(label), "%s lookup", name);
+    Bench::Report(label, count, lookupTime / runs);
+    std::snprintf(label, sizeof(label), "%s remove", name);
+    Bench::Report(label, count, removeTime / runs);
+}
+
+int main(){
+    const std::size_t counts[] = {10000, 100000, 1000000};
+
+    for(std::size_t count : counts){
+        std::printf("--- %zu entities ---\n", count);
+        runBenchmarks<MapComponentArray<BenchComponent>>("unordered_map", count);
+        runBenchmarks<ComponentArray<BenchComponent>>("sparse set", count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <ecs/ecs.hpp>
+
+// size in bytes of a single block of recorded component data
+const std::size_t COMMAND_BLOCK_SIZE = 16 * 1024;
+
+/* Command Buffer records structural changes (creating and destroying
+entities, adding and removing components) so they can be applied
+later at a sync point, such as after every system has been updated.
+Recording is thread safe so multiple threads can share one buffer.
+When applied, commands are sorted by entity and each entity's
+commands are applied together so every system is notified of an
+entity's signature change once, with archetype storage the entity
+is also moved into its final archetype once. Commands of an entity
+that gets destroyed within the same buffer are skipped entirely.
+*/
+class ECS::CommandBuffer{
+    private:
+        // type of a recorded command
+        enum class CommandType : std::uint8_t{
+            Add,
+            Remove,
+            Destroy
+        };
+
+        // a single recorded command
+        struct Command{
+            Entity entity;
+            CommandType type;
+            ComponentType component;
+
+            // recorded component of an add command, stored within the payload blocks
+            void* payload;
+
+            // moves the recorded component into the ECS storage and destroys the payload
+            void (*store)(Entity entity, ComponentType type, void* payload);
+
+            /* moves the recorded component into a given address and destroys the payload,
+             the destination is move assigned when it's constructed and move constructed otherwise
+            */
+            void (*place)(void* destination, void* payload, bool constructed);
+
+            // destroys the payload without storing it
+            void (*discard)(void* payload);
+        };
+
+        /* Payload Blocks stores the recorded components in fixed size
+        blocks so recording doesn't allocate for every command
+        */
+        struct PayloadBlocks{
+            // allocated blocks, kept between applies to be reused
+            std::vector<std::unique_ptr<std::byte[]>> blocks{};
+
+            // separately allocated payloads that don't fit within a block
+            std::vector<std::unique_ptr<std::byte[]>> large{};
+
+            // the block currently being filled
+            std::size_t blockIndex{};
+
+            // offset in bytes into the block currently being filled
+            std::size_t blockOffset{};
+
+            // get uninitialized memory for a payload of the given size and alignment
+            void* Allocate(std::size_t size, std::size_t alignment);
+
+            // forget every payload, blocks are kept for reuse
+            void Reset();
+        };
+
+        // recorded commands, in the order they were recorded
+        std::vector<Command> commands{};
+
+        // recorded components of the add commands
+        PayloadBlocks payloads{};
+
+        // guards the commands and payloads when recording from multiple threads
+        std::mutex mutex{};
+
+        // destroy the payloads of given commands without storing them
+        static void discardPayloads(std::vector<Command>& list);
+
+    public:
+        // public constructor
+        CommandBuffer() = default;
+
+        // destructor, any recorded commands that weren't applied are discarded
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /* reserve a new entity without locking, returns its handle or NULL_ENTITY when too many entities exist
+            @NOTE: the entity becomes alive when the buffer is applied, commands can be recorded for it right away
+            !Must not be called at the same time as other ECS functions other than those of command buffers and ECS::ReserveEntity()
+        */
+        Entity CreateEntity();
+
+        // record the destruction of an entity
+        void DestroyEntity(Entity entity);
+
+        /* record adding a component to an entity
+            @NOTE: if the entity already contains the component when applied, the component is replaced
+        */
+        template<typename T>
+        void AddComponent(Entity entity, T component){
+            EmplaceComponent<T>(entity, std::move(component));
+        }
+
+        /* record adding a component to an entity, the recorded component is constructed in place from the given arguments
+            @NOTE: if the entity already contains the component when applied, the component is replaced
+        */
+        template<typename T, typename... Args>
+        void EmplaceComponent(Entity entity, Args&&... args){
+            ComponentType type = ECS::componentManager->GetComponentType<T>();
+
+            //? check if component is not registered
+            if(type == UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to record component for entity: " << entity << " | component: " << typeid(T).name() << " isn't registered to ECS!" << "\n";
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            void* payload = payloads.Allocate(sizeof(T), alignof(T));
+            new (payload) T(std::forward<Args>(args)...);
+
+            commands.push_back({entity, CommandType::Add, type, payload,
+                [](Entity entity, ComponentType type, void* payload){
+                    T* component = static_cast<T*>(payload);
+                    ECS::storeComponent<T>(entity, type, *component);
+                    component->~T();
+                },
+                [](void* destination, void* payload, bool constructed){
+                    T* component = static_cast<T*>(payload);
+                    // tags have no storage to place into
+                    if constexpr(!IS_TAG_COMPONENT<T>){
+                        if(constructed){
+                            *static_cast<T*>(destination) = std::move(*component);
+                        }else{
+                            new (destination) T(std::move(*component));
+                        }
+                    }
+                    component->~T();
+                },
+                [](void* payload){
+                    static_cast<T*>(payload)->~T();
+                }});
+        }
+
+        // record removing a component from an entity
+        template<typename T>
+        void RemoveComponent(Entity entity){
+            ComponentType type = ECS::componentManager->GetComponentType<T>();
+
+            //? check if component is not registered
+            if(type == UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to record component removal for entity: " << entity << " | component: " << typeid(T).name() << " isn't registered to ECS!" << "\n";
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            commands.push_back({entity, CommandType::Remove, type, nullptr, nullptr, nullptr, nullptr});
+        }
+
+        /* apply every recorded command and clear the buffer
+            !Must be called from a sync point, while no system is iterating its entities
+        */
+        void Apply();
+
+        // get the amount of recorded commands
+        std::size_t Size(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return commands.size();
+        }
+
+        // check if no commands are recorded
+        bool Empty(){
+            return Size() == 0;
+        }
+};
+
+#endif
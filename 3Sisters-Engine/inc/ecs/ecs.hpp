@@ -4,11 +4,23 @@
 #define ECS_HPP
 
 #include <type_traits>
+#include <unordered_map>
+#include <span>
+#include <vector>
 
 // include all ecs managers
 #include <ecs/managers/entity_manager.hpp>
 #include <ecs/managers/component_manager.hpp>
 #include <ecs/managers/system_manager.hpp>
+#include <ecs/managers/archetype_manager.hpp>
+#include <ecs/managers/observer_manager.hpp>
+#include <ecs/managers/resource_manager.hpp>
+
+// include component view
+#include <ecs/types/component_view.hpp>
+
+// include shared components
+#include <ecs/types/shared.hpp>
 
 /* A static singleton ECS (aka coordinator) class that hosts
  several function to create, manage, remove Entities, Components,
@@ -21,17 +33,95 @@ class ECS{
             this function also contains debug options
             @ d - debug, debug outputs, error checking (default).
             @ r - release, skip most functional error checking and some debug outputs (use with caution).
+            and storage options
+            @ s - sparse, each component type is stored within its own packed array (default).
+            @ a - archetype, entities sharing a signature are stored together in 16 KiB chunks with a packed column per component.
+            and the maximum amount of entities that can exist simultaneously, capped at MAX_ENTITIES
+        */
+        static void Init(char debugOption = 'd', char storageOption = 's', Entity maxEntities = MAX_ENTITIES);
+
+        /* records structural changes to apply them later in one batch, see command_buffer.hpp
+            @ usage: ECS::CommandBuffer commands; commands.AddComponent(entity, Transform2D()); commands.Apply();
         */
-        static void Init(char debugOption = 'd');
+        class CommandBuffer;
 
         //* Entity Functions
 
-        // create an Entity, returns reference of created Entity
+        // create an Entity, returns handle of created Entity or NULL_ENTITY when too many entities exist
         static Entity CreateEntity();
 
+        /* reserve an Entity from any thread without locking, returns its handle or NULL_ENTITY when too many entities exist
+            @ usage: Entity debris = ECS::ReserveEntity(); commands.AddComponent(debris, Transform2D());
+            @NOTE: the handle becomes a living entity without components at the next sync point (applying a command buffer, creating or destroying entities, or ECS::FlushReservedEntities())
+            !May only run at the same time as other reservations and command buffer recording, such as from systems or parallel tasks
+        */
+        static Entity ReserveEntity(){
+            return entityManager->ReserveEntity();
+        }
+
+        /* turn every reserved Entity into a living entity
+            !Must be called from a sync point, while no thread is reserving entities
+        */
+        static void FlushReservedEntities(){
+            entityManager->FlushReserved();
+        }
+
         // destroy given Entity and remove attached components
         static void DestroyEntity(Entity entity);
 
+        /* create multiple entities that each get a copy of the given components, returns the handles of the created entities
+            @ usage: std::vector<Entity> bullets = ECS::CreateEntities(5000, Transform2D(), Material2D());
+            @NOTE: handles are allocated in one block, components are copied into storage in bulk and systems are updated once
+        */
+        template<typename... Args>
+        static std::vector<Entity> CreateEntities(std::size_t count, const Args&... prototypes){
+            // check the amount of arguments to the max components
+            static_assert(sizeof...(Args) < MAX_COMPONENTS, "ERROR: Too many specified component, the max is MAX_COMPONENTS");
+
+            //? check if every component is registered
+            if(((componentManager->GetComponentType<Args>() == UNREGISTERED_COMPONENT) || ...)){
+                std::cout << "ERROR: Failed to create entities as a component isn't registered to ECS!\n";
+                return {};
+            }
+
+            std::vector<Entity> entities(count);
+            entities.resize(entityManager->CreateEntities(entities.data(), count));
+
+            if constexpr(sizeof...(Args) > 0){
+                if(storageOption == 'a'){
+                    archetypeManager->AddComponents<Args...>(entities.data(), entities.size(), {componentManager->GetComponentType<Args>()...}, prototypes...);
+                }else{
+                    (componentManager->AddComponents<Args>(entities.data(), entities.size(), prototypes), ...);
+                }
+
+                Signature signature;
+                (signature.set(componentManager->GetComponentType<Args>(), true), ...);
+                for(Entity entity : entities){
+                    entityManager->SetSignature(entity, signature);
+                }
+
+                systemManager->EntitiesSignatureChange(entities.data(), entities.size(), Signature(), signature);
+
+                if((signature & observerManager->GetObserved(ComponentEvent::Add)).any()){
+                    for(Entity entity : entities){
+                        notify(ComponentEvent::Add, entity, signature);
+                    }
+                }
+            }
+
+            return entities;
+        }
+
+        /* destroy multiple entities and remove their attached components
+            @NOTE: systems are updated once for the whole batch, invalid handles are skipped
+        */
+        static void DestroyEntities(std::span<const Entity> entities);
+
+        // check if an entity handle refers to a living entity, handles of destroyed entities are never valid again
+        static bool IsValid(Entity entity){
+            return entityManager->IsValid(entity);
+        }
+
         // get an existing entity's component signature
         static Signature GetEntitySignature(Entity entity){
             return entityManager->GetSignature(entity);
@@ -39,39 +129,65 @@ class ECS{
         
         //* Component Functions
         
-        // register specified component for entity and system usage
+        /* register specified component for entity and system usage
+            @NOTE: empty types (e.g. struct Enemy{};) are tags, only which entities have them is kept
+        */
         template<typename T>
         static void RegisterComponent(){
             componentManager->RegisterComponent<T>();
+
+            // archetypes need to know how to move and destroy the component
+            if(storageOption == 'a'){
+                archetypeManager->RegisterComponent(componentManager->GetComponentType<T>(), ComponentInfo::Create<T>());
+            }
         }     
 
-        // add a specified component to an existing entity 
+        // add a specified component to an existing entity, the component is moved into storage
         template<typename T>
         static void AddComponent(Entity entity, T component){
+            //? check if the handle is stale
+            if(!checkEntity(entity, "add component to")){
+                return;
+            }
+
             //? check if component is not registered
-            if(componentManager->GetComponentType<T>() == 255){
+            if(componentManager->GetComponentType<T>() == UNREGISTERED_COMPONENT){
                 std::cout << "ERROR: Failed to add component to entity: " <<  entity << " | component: " << typeid(T).name() << " isn't registered to ECS!" << "\n";
                 return;
             }
             // else add component to existing entity
 
-            componentManager->AddComponent<T>(entity,component);
+            if(storageOption == 'a'){
+                if(!archetypeManager->AddComponents<T>(entity, {componentManager->GetComponentType<T>()}, component)){
+                    return;
+                }
+            }else{
+                componentManager->AddComponent<T>(entity, std::move(component));
+            }
 
-            Signature signature = entityManager->GetSignature(entity); 
+            Signature oldSignature = entityManager->GetSignature(entity);
+            Signature signature = oldSignature;
             signature.set(componentManager->GetComponentType<T>(), true);
             entityManager->SetSignature(entity, signature);
 
-            systemManager->EntitySignatureChange(entity, signature);
+            systemManager->EntitySignatureChange(entity, oldSignature, signature);
+
+            notify(ComponentEvent::Add, entity, signature & ~oldSignature);
         }
 
-        // add a list of components to an existing entity
+        // add a list of components to an existing entity, the components are moved into storage
         template<typename... Args>
         static void AddComponent(Entity entity, Args... args){
             // check the amount of arguments to the max components
-            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified component, the max is 32");
+            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified component, the max is MAX_COMPONENTS");
+
+            //? check if the handle is stale
+            if(!checkEntity(entity, "add component to")){
+                return;
+            }
 
             //? check if every component is not registered
-            if(((componentManager->GetComponentType<Args>() == 255) ||  ...)){
+            if(((componentManager->GetComponentType<Args>() == UNREGISTERED_COMPONENT) ||  ...)){
                 //TODO: Find a way to print the exact argument's name that isn't registered (for now this should still be helpful)
                 std::cout << "ERROR: Failed to add component to entity: " <<  entity << " | a component isn't registered to ECS!" << "\n";
                 return;
@@ -79,45 +195,438 @@ class ECS{
 
             // else add each component to the exisiting entity
 
-            (componentManager->AddComponent<Args>(entity, args), ...);
+            if(storageOption == 'a'){
+                // nothing changes when none of the components were added
+                if(!archetypeManager->AddComponents<Args...>(entity, {componentManager->GetComponentType<Args>()...}, args...)){
+                    return;
+                }
+            }else{
+                (componentManager->AddComponent<Args>(entity, std::move(args)), ...);
+            }
 
-            Signature signature = entityManager->GetSignature(entity);
+            Signature oldSignature = entityManager->GetSignature(entity);
+            Signature signature = oldSignature;
             (signature.set(componentManager->GetComponentType<Args>(), true), ...);
             entityManager->SetSignature(entity, signature);
 
-            systemManager->EntitySignatureChange(entity, signature);
+            systemManager->EntitySignatureChange(entity, oldSignature, signature);
+
+            notify(ComponentEvent::Add, entity, signature & ~oldSignature);
+        }
+
+        /* construct a component in place for an existing entity from the given arguments, returns a pointer to the component
+            @ usage: ECS::EmplaceComponent<Path>(entity, std::move(points), 1.0f)
+            @NOTE: returns nullptr if the component couldn't be added, move-only components are supported
+        */
+        template<typename T, typename... Args>
+        static T* EmplaceComponent(Entity entity, Args&&... args){
+            //? check if the handle is stale
+            if(!checkEntity(entity, "add component to")){
+                return nullptr;
+            }
+
+            //? check if component is not registered
+            if(componentManager->GetComponentType<T>() == UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to add component to entity: " <<  entity << " | component: " << typeid(T).name() << " isn't registered to ECS!" << "\n";
+                return nullptr;
+            }
+
+            T* component;
+            if(storageOption == 'a'){
+                component = archetypeManager->EmplaceComponent<T>(entity, componentManager->GetComponentType<T>(), std::forward<Args>(args)...);
+            }else{
+                component = componentManager->EmplaceComponent<T>(entity, std::forward<Args>(args)...);
+            }
+
+            if(component == nullptr){
+                return nullptr;
+            }
+
+            Signature oldSignature = entityManager->GetSignature(entity);
+            Signature signature = oldSignature;
+            signature.set(componentManager->GetComponentType<T>(), true);
+            entityManager->SetSignature(entity, signature);
+
+            systemManager->EntitySignatureChange(entity, oldSignature, signature);
+
+            notify(ComponentEvent::Add, entity, signature & ~oldSignature);
+
+            return component;
         }
 
         // remove a component from an existing entity
         template<typename T>
         static void RemoveComponent(Entity entity){
+            //? check if the handle is stale
+            if(!checkEntity(entity, "remove component from")){
+                return;
+            }
+
             //? check if component is not registered
-            if(componentManager->GetComponentType<T>() == 255){
+            if(componentManager->GetComponentType<T>() == UNREGISTERED_COMPONENT){
                 std::cout << "ERROR: Failed to remove component to entity: " <<  entity << " | component: " << typeid(T).name() << " isn't registered to ECS!" << "\n";
                 return;
             }
 
-            componentManager->RemoveComponent<T>(entity);
+            // observers see the component before it is removed
+            notify(ComponentEvent::Remove, entity, GetComponentSignature<T>());
 
-            Signature signature = entityManager->GetSignature(entity);
+            if(storageOption == 'a'){
+                archetypeManager->RemoveComponent(entity, componentManager->GetComponentType<T>());
+            }else{
+                componentManager->RemoveComponent<T>(entity);
+            }
+
+            Signature oldSignature = entityManager->GetSignature(entity);
+            Signature signature = oldSignature;
             signature.set(componentManager->GetComponentType<T>(), false);
             entityManager->SetSignature(entity, signature);
 
-            systemManager->EntitySignatureChange(entity, signature);
+            systemManager->EntitySignatureChange(entity, oldSignature, signature);
         }
 
         // get reference of an exiting entity's component
         template<typename T>
         static T& GetComponent(Entity entity){
+            //? check if the handle is stale
+            if(!entityManager->IsValid(entity)){
+                // throw an exception, throws message and crashes the program
+                throw std::invalid_argument(std::string("ERROR: Can't get component: ") + typeid(T).name() + " of an entity that isn't alive");
+            }
+
+            if(storageOption == 'a'){
+                T* component = static_cast<T*>(archetypeManager->GetComponent(entity, componentManager->GetComponentType<T>()));
+                if(component == nullptr){
+                    // throw an exception, throws message and crashes the program
+                    throw std::invalid_argument(std::string("ERROR: Can't find entity with component: ") + typeid(T).name());
+                }
+                return *component;
+            }
+
             return componentManager->GetComponent<T>(entity);
         }
 
         // check if entity has such component
         template<typename T>
         static bool CheckComponent(Entity entity){
+            // stale handles have no components
+            if(!entityManager->IsValid(entity)){
+                return false;
+            }
+
+            if(storageOption == 'a'){
+                return archetypeManager->GetComponent(entity, componentManager->GetComponentType<T>()) != nullptr;
+            }
+
             return componentManager->CheckComponent<T>(entity);
         }
 
+        /* create a view of every entity that contains all given components and none of the excluded components
+            @ usage: for(auto [entity, transform, material] : ECS::View<Transform2D, Material2D>())
+            @ or: ECS::View<Transform2D, Material2D>().Each([](Entity entity, Transform2D& transform, Material2D& material){})
+            @ without: ECS::View<Transform2D>(ECS::GetComponentSignature<Frozen>())
+            !Adding or removing components while iterating invalidates the view
+        */
+        template<typename... Ts>
+        static ComponentView<Ts...> View(Signature without = Signature()){
+            //? check if every component is registered
+            if(((componentManager->GetComponentType<Ts>() == UNREGISTERED_COMPONENT) || ...)){
+                std::cout << "ERROR: Failed to create view as a component isn't registered to ECS!\n";
+                return ComponentView<Ts...>();
+            }
+
+            if(storageOption == 'a'){
+                Signature query;
+                (query.set(componentManager->GetComponentType<Ts>()), ...);
+
+                return ComponentView<Ts...>(archetypeManager->GetArchetypes(query, without), {componentManager->GetComponentType<Ts>()...});
+            }
+
+            // gather the component arrays of the excluded components
+            std::vector<IComponentArray*> excluded;
+            without.ForEach([&excluded](ComponentType type){
+                if(componentManager->GetComponentArray(type) != nullptr){
+                    excluded.push_back(componentManager->GetComponentArray(type));
+                }
+            });
+
+            return ComponentView<Ts...>(std::move(excluded), componentManager->GetComponentArray<Ts>()...);
+        }
+
+        /* call a function on every chunk of entities that contain all given components and none of the excluded components
+            @ function signature: void(std::size_t count, Entity* entities, Ts*... components)
+            @ each component pointer is a packed column of 'count' elements matching the entities
+            @NOTE: tags have no column, their pointer is a single instance shared by every entity and must not be indexed
+            !Requires the ECS to be initialized with archetype storage
+            !Adding or removing components within the function invalidates the given columns
+        */
+        template<typename... Ts, typename Func>
+        static void ForEachChunk(Func func, Signature without = Signature()){
+            if(storageOption != 'a'){
+                std::cout << "ERROR: Failed to iterate chunks as the ECS isn't using archetype storage!\n";
+                return;
+            }
+
+            //? check if every component is registered
+            if(((componentManager->GetComponentType<Ts>() == UNREGISTERED_COMPONENT) || ...)){
+                std::cout << "ERROR: Failed to iterate chunks as a component isn't registered to ECS!\n";
+                return;
+            }
+
+            archetypeManager->ForEachChunk<Ts...>({componentManager->GetComponentType<Ts>()...}, func, without);
+        }
+
+        //* Resource Functions
+
+        /* set a global resource that isn't attached to any entity, only one resource of each type exists
+            @ usage: ECS::SetResource<PhysicsSettings>(9.81f);
+            @NOTE: an existing resource is replaced in place so references to it stay valid
+            !Must not be called from systems or while ECS::UpdateSystems() runs, systems on other threads may be reading resources
+        */
+        template<typename T, typename... Args>
+        static T& SetResource(Args&&... args){
+            return resourceManager->SetResource<T>(std::forward<Args>(args)...);
+        }
+
+        /* get reference of a global resource
+            @NOTE: the reference stays valid until the resource is removed, systems can keep it instead of getting it every update
+        */
+        template<typename T>
+        static T& GetResource(){
+            T* resource = resourceManager->GetResource<T>();
+            if(resource == nullptr){
+                // throw an exception, throws message and crashes the program
+                throw std::invalid_argument(std::string("ERROR: Can't find resource: ") + typeid(T).name());
+            }
+            return *resource;
+        }
+
+        // check if a global resource is set
+        template<typename T>
+        static bool CheckResource(){
+            return resourceManager->GetResource<T>() != nullptr;
+        }
+
+        // remove a global resource
+        template<typename T>
+        static void RemoveResource(){
+            resourceManager->RemoveResource<T>();
+        }
+
+        //* Change Tracking Functions
+
+        /* stamp an entity's component as changed and call the component's change observers
+            @NOTE: components aren't tracked when modified through a reference, changes have to be marked
+        */
+        template<typename T>
+        static void MarkChanged(Entity entity){
+            //? check if the handle is stale
+            if(!checkEntity(entity, "mark changed component of")){
+                return;
+            }
+
+            ComponentType type = componentManager->GetComponentType<T>();
+
+            if(storageOption == 'a'){
+                archetypeManager->MarkChanged(entity, type);
+            }else{
+                componentManager->MarkChanged(entity, type);
+            }
+
+            notify(ComponentEvent::Change, entity, GetComponentSignature<T>());
+        }
+
+        /* modify an entity's component through a function and mark it as changed
+            @ usage: ECS::Patch<Transform2D>(entity, [](Transform2D& transform){ transform.position.x += 1.0f; });
+        */
+        template<typename T, typename Func>
+        static void Patch(Entity entity, Func func){
+            //? check if the handle is stale
+            if(!checkEntity(entity, "patch")){
+                return;
+            }
+
+            T* component = static_cast<T*>(getComponentData(entity, componentManager->GetComponentType<T>()));
+            if(component == nullptr){
+                std::cout << "ERROR: Failed to patch entity: " << entity << " as it doesn't have component: " << typeid(T).name() << "\n";
+                return;
+            }
+
+            func(*component);
+            MarkChanged<T>(entity);
+        }
+
+        // get the change tick new and changed components are stamped with
+        static std::uint32_t GetChangeTick(){
+            return ChangeTick::Get();
+        }
+
+        /* advance the change tick, returns the new tick
+            @ usage: std::uint32_t tick = ECS::AdvanceChangeTick(); ECS::ForEachChanged<Transform2D>(lastTick, ...); lastTick = tick;
+            @NOTE: components changed after advancing are stamped with the returned tick, so they are found when looking from it
+            @NOTE: ECS::UpdateSystems() already advances the tick, a system only advances it again when changes it already saw must not be seen twice
+            @NOTE: advancing from a system is safe for other consumers, comparisons at or after a remembered tick never miss a change
+        */
+        static std::uint32_t AdvanceChangeTick(){
+            return ChangeTick::Advance();
+        }
+
+        // check if an entity's component was added or changed at or after a given change tick
+        template<typename T>
+        static bool HasChanged(Entity entity, std::uint32_t sinceTick){
+            // stale handles have no components
+            if(!entityManager->IsValid(entity)){
+                return false;
+            }
+
+            // unregistered components never change
+            ComponentType type = componentManager->GetComponentType<T>();
+            if(type == UNREGISTERED_COMPONENT){
+                return false;
+            }
+
+            if(storageOption == 'a'){
+                return archetypeManager->GetComponent(entity, type) != nullptr && ChangeTick::IsNewer(archetypeManager->GetChangeTick(entity, type), sinceTick);
+            }
+
+            ComponentArray<T>* array = componentManager->GetComponentArray<T>();
+            if(array == nullptr){
+                return false;
+            }
+            return array->CheckData(entity) && ChangeTick::IsNewer(array->GetChangeTick(entity), sinceTick);
+        }
+
+        /* call a function on every component of a type that was added or changed at or after a given change tick
+            @ function signature: void(Entity entity, T& component)
+            !Adding or removing components within the function is not allowed
+        */
+        template<typename T, typename Func>
+        static void ForEachChanged(std::uint32_t sinceTick, Func func){
+            //? check if component is not registered
+            if(componentManager->GetComponentType<T>() == UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to iterate changes as component: " << typeid(T).name() << " isn't registered to ECS!\n";
+                return;
+            }
+
+            if(storageOption == 'a'){
+                archetypeManager->ForEachChanged<T>(componentManager->GetComponentType<T>(), sinceTick, func);
+            }else{
+                componentManager->GetComponentArray<T>()->ForEachChanged(sinceTick, func);
+            }
+        }
+
+        //* Shared Component Functions
+
+        /* get the value an entity's shared component references
+            @ usage: const Material2D& material = ECS::GetShared<Material2D>(entity);
+            @NOTE: the Shared<T> component must be registered, see shared.hpp
+        */
+        template<typename T>
+        static const T& GetShared(Entity entity){
+            return GetComponent<Shared<T>>(entity).Get();
+        }
+
+        /* change an entity's shared value through a function, copying it first so other entities keep the old value
+            @ usage: ECS::PatchShared<Material2D>(entity, [](Material2D& material){ material.color.a = 0.5f; });
+        */
+        template<typename T, typename Func>
+        static void PatchShared(Entity entity, Func func){
+            Patch<Shared<T>>(entity, [&](Shared<T>& shared){
+                shared.Modify(func);
+            });
+        }
+
+        /* call a function once for every distinct shared value with every entity referencing it, grouped in a single pass without sorting
+            @ usage: ECS::ForEachSharedGroup<Material2D>([](const Material2D& material, std::span<const Entity> entities){});
+            !Adding or removing components within the function is not allowed
+        */
+        template<typename T, typename Func>
+        static void ForEachSharedGroup(Func func){
+            // kept between calls so their memory is reused, each thread has its own
+            static thread_local std::vector<std::pair<const T*, std::vector<Entity>>> scratchGroups;
+            static thread_local std::unordered_map<const void*, std::size_t> scratchIndices;
+
+            // taken out for the call, so calling this again from within the function stays correct
+            std::vector<std::pair<const T*, std::vector<Entity>>> groups = std::move(scratchGroups);
+            std::unordered_map<const void*, std::size_t> groupIndices = std::move(scratchIndices);
+
+            // entities of each distinct value, in order of first appearance
+            std::size_t used = 0;
+            View<Shared<T>>().Each([&](Entity entity, Shared<T>& shared){
+                if(!shared){
+                    return;
+                }
+
+                auto [found, inserted] = groupIndices.try_emplace(shared.GetId(), used);
+                if(inserted){
+                    if(used == groups.size()){
+                        groups.emplace_back();
+                    }
+                    groups[used].first = &shared.Get();
+                    groups[used].second.clear();
+                    used++;
+                }
+                groups[found->second].second.push_back(entity);
+            });
+
+            for(std::size_t i = 0; i < used; i++){
+                func(*groups[i].first, std::span<const Entity>(groups[i].second));
+            }
+
+            groupIndices.clear();
+            scratchGroups = std::move(groups);
+            scratchIndices = std::move(groupIndices);
+        }
+
+        //* Snapshot Functions
+
+        /* save every entity and the components of every trivially copyable component type into a binary snapshot
+            @NOTE: each component pool is written as one contiguous blob, components that aren't trivially copyable are skipped
+            @NOTE: snapshots can only be loaded by a build with the same entity handle size and component layouts
+        */
+        static bool SaveSnapshot(std::vector<std::byte>& output);
+
+        /* replace the world with a binary snapshot, every current entity is destroyed first
+            @NOTE: handles within the snapshot stay valid, observers aren't called for the loaded components
+            @NOTE: components are matched to registered components by type name and size, unknown components are skipped
+        */
+        static bool LoadSnapshot(const std::byte* data, std::size_t size);
+
+        // save a binary snapshot of the world into a file
+        static bool SaveWorld(const char* path);
+
+        // replace the world with a binary snapshot read from a file
+        static bool LoadWorld(const char* path);
+
+        //* Observer Functions
+
+        /* call a function whenever a component of a type is added to an entity
+            @ function signature: void(Entity entity, T& component)
+            !Observers must not create/destroy entities or add/remove components directly, record them within an ECS::CommandBuffer instead
+        */
+        template<typename T, typename Func>
+        static void OnAdd(Func func){
+            addObserver<T>(ComponentEvent::Add, func);
+        }
+
+        /* call a function whenever a component of a type is about to be removed from an entity, including when the entity is destroyed
+            @ function signature: void(Entity entity, T& component)
+            !Observers must not create/destroy entities or add/remove components directly, record them within an ECS::CommandBuffer instead
+        */
+        template<typename T, typename Func>
+        static void OnRemove(Func func){
+            addObserver<T>(ComponentEvent::Remove, func);
+        }
+
+        /* call a function whenever a component of a type is marked as changed
+            @ function signature: void(Entity entity, T& component)
+            @NOTE: may be called from worker threads when components are marked as changed within system updates
+        */
+        template<typename T, typename Func>
+        static void OnChange(Func func){
+            addObserver<T>(ComponentEvent::Change, func);
+        }
+
         // get component type of given component
         template<typename T>
         static ComponentType GetComponentType(){
@@ -141,10 +650,10 @@ class ECS{
         template<typename... Args>
         static Signature GetMultiComponentSignature(Args... args){
             // check the amount of arguments to the max components
-            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified component, the max is 32");
+            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified component, the max is MAX_COMPONENTS");
 
             // check if args are of type ComponentType
-            static_assert((std::is_same_v<Args, ComponentType> && ...), "ERROR: Invalid signature argument as all component types are of std::uint8_t"); 
+            static_assert((std::is_same_v<Args, ComponentType> && ...), "ERROR: Invalid signature argument as all component types are of ComponentType"); 
             
             // create signature to fill
             Signature sig;
@@ -160,17 +669,13 @@ class ECS{
             return sig;
         }
         
-        // get signature bit of a component type
+        /* get signature bit of a component type
+            @NOTE: only component types below 32 fit, 0 is returned for the rest
+        */
         template<typename T>
         static unsigned int GetComponentSignatureBit(){
-            // create signature to fill
-            Signature sig;
-            
-            // fill signature
-            sig.set(componentManager->GetComponentType<T>());
-            
-            // return the signature
-            return (unsigned int)sig.to_ulong();
+            ComponentType type = componentManager->GetComponentType<T>();
+            return type < 32 ? 1u << type : 0;
         }
 
         //* System Functions
@@ -201,10 +706,10 @@ class ECS{
         template<typename T, typename... Args>
         static void SetSystemSignature(Args... args){
             // check if args are of type ComponentType
-            static_assert((std::is_same_v<Args, ComponentType> && ...), "ERROR: Invalid signature argument as all component types are of std::uint8_t"); 
+            static_assert((std::is_same_v<Args, ComponentType> && ...), "ERROR: Invalid signature argument as all component types are of ComponentType"); 
             
             // check the amount of arguments to the max components
-            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified signature component types, the max is 32");
+            static_assert(sizeof...(args) < MAX_COMPONENTS, "ERROR: Too many specified signature component types, the max is MAX_COMPONENTS");
 
             // create signature to fill
             Signature sig;
@@ -219,6 +724,44 @@ class ECS{
             systemManager->SetSignature<T>(sig);
         }
 
+        /* set the component types that entities of a system must not have, entities gaining one leave the system
+            @ usage: ECS::SetSystemExclusion<Movement>(ECS::GetComponentSignature<Frozen>());
+        */
+        template<typename T>
+        static void SetSystemExclusion(Signature exclusion){
+            systemManager->SetExclusion<T>(exclusion);
+        }
+
+        /* set the component types a system reads and writes within its Update()
+            @ usage: ECS::SetSystemAccess<Physics>(ECS::GetComponentSignature<RigidBody>(), ECS::GetComponentSignature<Transform2D>())
+            @NOTE: systems without declared access never run concurrently with other systems
+        */
+        template<typename T>
+        static void SetSystemAccess(Signature reads, Signature writes){
+            systemManager->SetAccess<T>(reads, writes);
+        }
+
+        /* set how ECS::UpdateSystems() updates the systems
+            @ p - parallel, systems that don't write components accessed by each other run concurrently on worker threads (default).
+            @ s - serial, systems run one after another in order of registration on the calling thread, fully deterministic.
+            and the amount of worker threads for the parallel option, 0 uses a thread for each hardware thread except the calling thread
+        */
+        static void SetScheduler(char schedulerOption = 'p', std::size_t threadCount = 0){
+            systemManager->SetScheduler(schedulerOption, threadCount);
+        }
+
+        /* call Update() of every registered system, returns once every system is done
+            @NOTE: systems that access the same components always update in order of registration
+            @NOTE: the change tick is advanced once before any system updates, systems that advance it themselves (e.g. TransformSystem) can move it further
+            !Structural changes made from systems must be recorded within an ECS::CommandBuffer and applied after this returns
+        */
+        static void UpdateSystems(double deltaTime){
+            // advanced on the calling thread, systems on worker threads only read it
+            ChangeTick::Advance();
+
+            systemManager->UpdateSystems(deltaTime);
+        }
+
     private:
         // private constructor
         ECS() {}
@@ -231,6 +774,78 @@ class ECS{
 
         // private pointer storage of the system manager
         static std::unique_ptr<SystemManager> systemManager;
+
+        // private pointer storage of the archetype manager, only used with archetype storage
+        static std::unique_ptr<ArchetypeManager> archetypeManager;
+
+        // private pointer storage of the observer manager
+        static std::unique_ptr<ObserverManager> observerManager;
+
+        // private pointer storage of the resource manager
+        static std::unique_ptr<ResourceManager> resourceManager;
+
+        // private storage of the storage option
+        static char storageOption;
+
+        // insert a component into the storage without updating signatures, an existing component is replaced
+        template<typename T>
+        static void storeComponent(Entity entity, ComponentType type, T& component){
+            if(storageOption == 'a'){
+                T* existing = static_cast<T*>(archetypeManager->GetComponent(entity, type));
+                if(existing != nullptr){
+                    *existing = std::move(component);
+                    archetypeManager->MarkChanged(entity, type);
+                }else{
+                    archetypeManager->AddComponents<T>(entity, {type}, component);
+                }
+                return;
+            }
+
+            ComponentArray<T>* array = componentManager->GetComponentArray<T>();
+            T* existing = array->TryGetData(entity);
+            if(existing != nullptr){
+                *existing = std::move(component);
+                array->MarkChanged(entity);
+            }else{
+                array->InsertData(entity, std::move(component));
+            }
+        }
+
+        // remove a component from the storage without updating signatures, nothing happens if the entity doesn't contain it
+        static void eraseComponent(Entity entity, ComponentType type);
+
+        // get the address of an entity's component, returns nullptr if the entity doesn't contain it
+        static void* getComponentData(Entity entity, ComponentType type);
+
+        // check if a handle refers to a living entity, prints which action failed otherwise
+        static bool checkEntity(Entity entity, const char* action){
+            if(entityManager->IsValid(entity)){
+                return true;
+            }
+
+            std::cout << "ERROR: Failed to " << action << " entity: " << entity << " as it isn't alive!\n";
+            return false;
+        }
+
+        // call the observers of an event for each given component type of an entity
+        static void notify(ComponentEvent event, Entity entity, Signature types);
+
+        // add an observer that casts the component to its type
+        template<typename T, typename Func>
+        static void addObserver(ComponentEvent event, Func func){
+            //? check if component is not registered
+            if(componentManager->GetComponentType<T>() == UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to add observer as component: " << typeid(T).name() << " isn't registered to ECS!\n";
+                return;
+            }
+
+            observerManager->AddObserver(event, componentManager->GetComponentType<T>(), [func](Entity entity, void* component){
+                func(entity, *static_cast<T*>(component));
+            });
+        }
 };
 
+// include the command buffer after the ECS is defined as it depends on it
+#include <ecs/command_buffer.hpp>
+
 #endif
\ No newline at end of file
@@ -0,0 +1,323 @@
+#pragma once
+
+#ifndef ARCHETYPE_MANAGER_HPP
+#define ARCHETYPE_MANAGER_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <utility>
+#include <iostream>
+
+#include <ecs/types/entity.hpp>
+#include <ecs/types/component.hpp>
+#include <ecs/types/signature.hpp>
+#include <ecs/types/archetype.hpp>
+#include <ecs/types/paged_array.hpp>
+
+/* Archetype Manager owns every archetype and keeps record
+of which archetype and row each entity's components live in.
+When an entity gains or loses a component it is moved into
+the archetype matching its new signature.
+*/
+class ArchetypeManager{
+    private:
+        // location of an entity's components
+        struct EntityRecord{
+            Archetype* archetype = nullptr;
+            std::size_t row = 0;
+        };
+
+        // map from a signature to the archetype storing it
+        std::unordered_map<Signature, std::unique_ptr<Archetype>> archetypes{};
+
+        // list of all archetypes in order of creation, used for iteration
+        std::vector<Archetype*> archetypeList{};
+
+        // type-erased info of each registered component type
+        std::array<ComponentInfo, MAX_COMPONENTS> componentInfos{};
+
+        // paged array of records where the index corresponds to the entity index
+        PagedArray<EntityRecord> records{};
+
+        // private storage of the debug option
+        char debugOption;
+
+        // get the archetype of a given signature, creates it if it doesn't exist
+        Archetype* getArchetype(Signature signature);
+
+        /* move an entity into the archetype matching a new signature, returns the new archetype
+            @NOTE: returns nullptr when the new signature is empty
+        */
+        Archetype* moveEntity(Entity entity, Signature signature);
+
+        // construct a component in place at the entity's current row from the given arguments
+        template<typename T, typename... Args>
+        T* constructComponent(Entity entity, ComponentType type, [[maybe_unused]] Args&&... args){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                EntityRecord& record = records[GetEntityIndex(entity)];
+                record.archetype->MarkChanged(type, record.row, ChangeTick::Get());
+                return new (record.archetype->GetComponent(type, record.row)) T(std::forward<Args>(args)...);
+            }
+        }
+
+        /* move an entity into the archetype containing its current components and the given ones,
+         returns the signature of the components that were added, components the entity already contains are skipped
+            @NOTE: the added components are left unconstructed
+        */
+        template<std::size_t N>
+        Signature addColumns(Entity entity, const std::array<ComponentType, N>& types){
+            Signature current;
+            EntityRecord& record = records.Assure(GetEntityIndex(entity));
+            if(record.archetype != nullptr){
+                // the row must belong to the given handle, not to another generation of the entity
+                if(record.archetype->GetEntity(record.row) != entity){
+                    std::cout << "ERROR: Entity's slot is still used by another entity!\n";
+                    return Signature{};
+                }
+                current = record.archetype->GetSignature();
+            }
+
+            // build the signature of the new archetype
+            Signature added;
+            for(ComponentType type : types){
+                if(current.test(type)){
+                    std::cout << "ERROR: Entity already contains given component!\n";
+                    continue;
+                }
+                added.set(type);
+            }
+
+            if(added.any()){
+                moveEntity(entity, current | added);
+            }
+
+            return added;
+        }
+
+        // copy construct a component into a range of rows, one chunk at a time
+        template<typename T>
+        void fillColumn(Archetype* archetype, ComponentType type, std::size_t first, std::size_t amount, const T& prototype){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return;
+            }
+
+            std::size_t capacity = archetype->GetChunkCapacity();
+            std::size_t filled = 0;
+
+            while(filled < amount){
+                std::size_t row = first + filled;
+                std::size_t space = capacity - (row % capacity);
+                std::size_t batch = (amount - filled) < space ? (amount - filled) : space;
+
+                T* column = static_cast<T*>(archetype->GetChunkColumn(type, row / capacity));
+                std::uninitialized_fill_n(column + (row % capacity), batch, prototype);
+                filled += batch;
+            }
+
+            archetype->MarkChanged(type, first, ChangeTick::Get(), amount);
+        }
+
+        // get the column of a component within a chunk, tags give their single instance
+        template<typename T>
+        T* getColumn(Archetype* archetype, ComponentType type, std::size_t chunk){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                return static_cast<T*>(archetype->GetChunkColumn(type, chunk));
+            }
+        }
+
+        // call a function on every chunk column of an archetype
+        template<typename... Ts, typename Func, std::size_t... Is>
+        void forEachChunk(Archetype* archetype, const std::array<ComponentType, sizeof...(Ts)>& types, Func& func, std::index_sequence<Is...>){
+            for(std::size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++){
+                std::size_t size = archetype->GetChunkSize(chunk);
+                if(size == 0){
+                    continue;
+                }
+                func(size, archetype->GetChunkEntities(chunk), getColumn<Ts>(archetype, types[Is], chunk)...);
+            }
+        }
+
+    public:
+        // public constructor
+        ArchetypeManager(char option = 'd');
+
+        // register the type-erased info of a component type
+        void RegisterComponent(ComponentType type, ComponentInfo info);
+
+        /* add components of given types to an entity, moving the entity into its new archetype once, the given components are moved from
+         returns false if none of the components were added
+            @NOTE: components the entity already contains are skipped and keep their value
+        */
+        template<typename... Args>
+        bool AddComponents(Entity entity, const std::array<ComponentType, sizeof...(Args)>& types, Args&... components){
+            Signature added = addColumns(entity, types);
+            if(added.none()){
+                return false;
+            }
+
+            // move construct the newly added components
+            std::size_t index = 0;
+            ((added.test(types[index]) ? (void)constructComponent<Args>(entity, types[index], std::move(components)) : (void)0, index++), ...);
+
+            return true;
+        }
+
+        // construct a component in place for an entity from the given arguments, returns nullptr if it couldn't be added
+        template<typename T, typename... Args>
+        T* EmplaceComponent(Entity entity, ComponentType type, Args&&... args){
+            if(addColumns<1>(entity, {type}).none()){
+                return nullptr;
+            }
+
+            return constructComponent<T>(entity, type, std::forward<Args>(args)...);
+        }
+
+        /* give multiple entities without any components a copy of each given component
+            @NOTE: the entities are added to the archetype in one batch and each component column is filled per chunk
+        */
+        template<typename... Args>
+        void AddComponents(const Entity* entities, std::size_t amount, const std::array<ComponentType, sizeof...(Args)>& types, const Args&... prototypes){
+            Signature signature;
+            for(ComponentType type : types){
+                signature.set(type);
+            }
+
+            auto [archetype, first] = PushEntities(entities, amount, signature);
+
+            // fill each new component column with copies of the prototypes
+            std::size_t index = 0;
+            (fillColumn<Args>(archetype, types[index++], first, amount, prototypes), ...);
+        }
+
+        /* add multiple entities without any components into the archetype of a signature, returns the archetype and the row of the first entity
+            @NOTE: the components of the new rows are left unconstructed and must be constructed by the caller
+        */
+        std::pair<Archetype*, std::size_t> PushEntities(const Entity* entities, std::size_t amount, Signature signature){
+            Archetype* archetype = getArchetype(signature);
+            std::size_t first = archetype->PushEntities(entities, amount);
+
+            for(std::size_t i = 0; i < amount; i++){
+                records.Assure(GetEntityIndex(entities[i])) = {archetype, first + i};
+            }
+
+            return {archetype, first};
+        }
+
+        // remove a component from an entity, moving the entity into its new archetype
+        void RemoveComponent(Entity entity, ComponentType type);
+
+        /* move an entity straight into the archetype of a given signature, its components outside of the signature are destroyed
+            @NOTE: components the entity didn't contain before are left unconstructed and must be constructed by the caller
+        */
+        void MoveEntity(Entity entity, Signature signature){
+            records.Assure(GetEntityIndex(entity));
+            moveEntity(entity, signature);
+        }
+
+        // stamp an entity's component as changed with the current change tick
+        void MarkChanged(Entity entity, ComponentType type){
+            if(GetComponent(entity, type) != nullptr){
+                EntityRecord& record = records[GetEntityIndex(entity)];
+                record.archetype->MarkChanged(type, record.row, ChangeTick::Get());
+            }
+        }
+
+        // get the change tick an entity's component was last added or changed at, returns 0 if the entity doesn't contain it
+        std::uint32_t GetChangeTick(Entity entity, ComponentType type){
+            if(GetComponent(entity, type) == nullptr){
+                return 0;
+            }
+
+            EntityRecord& record = records[GetEntityIndex(entity)];
+            return record.archetype->GetChangeTick(type, record.row);
+        }
+
+        /* call a function on every component of a type added or changed at or after a given change tick,
+         chunks without any such component are skipped
+            @ function signature: void(Entity entity, T& component)
+        */
+        template<typename T, typename Func>
+        void ForEachChanged(ComponentType type, std::uint32_t sinceTick, Func func){
+            for(Archetype* archetype : archetypeList){
+                if(!archetype->HasComponent(type)){
+                    continue;
+                }
+
+                for(std::size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++){
+                    std::size_t size = archetype->GetChunkSize(chunk);
+                    if(size == 0 || !ChangeTick::IsNewer(archetype->GetChunkChangeTick(type, chunk), sinceTick)){
+                        continue;
+                    }
+
+                    Entity* entities = archetype->GetChunkEntities(chunk);
+                    T* components = static_cast<T*>(archetype->GetChunkColumn(type, chunk));
+                    std::uint32_t* ticks = archetype->GetChunkChangeTicks(type, chunk);
+
+                    for(std::size_t i = 0; i < size; i++){
+                        if(ChangeTick::IsNewer(ticks[i], sinceTick)){
+                            func(entities[i], components[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+        // get the address of an entity's component, returns nullptr if the entity doesn't contain it
+        void* GetComponent(Entity entity, ComponentType type){
+            if(!records.Contains(GetEntityIndex(entity))){
+                return nullptr;
+            }
+
+            // the row must still belong to the given handle to reject stale generations
+            EntityRecord& record = records[GetEntityIndex(entity)];
+            if(record.archetype == nullptr || record.archetype->GetEntity(record.row) != entity){
+                return nullptr;
+            }
+
+            // tags have no column, every entity with the tag shares its instance
+            if(componentInfos[type].tagInstance != nullptr){
+                return record.archetype->GetSignature().test(type) ? componentInfos[type].tagInstance : nullptr;
+            }
+            return record.archetype->GetComponent(type, record.row);
+        }
+
+        // remove all components of a destroyed entity
+        void EntityDestroyed(Entity entity);
+
+        // get every archetype that contains all components of a given signature and none of an excluded signature
+        std::vector<Archetype*> GetArchetypes(const Signature& query, const Signature& without = Signature()){
+            std::vector<Archetype*> matching;
+            for(Archetype* archetype : archetypeList){
+                if(archetype->GetSignature().Matches(query, without)){
+                    matching.push_back(archetype);
+                }
+            }
+            return matching;
+        }
+
+        /* call a function on every chunk whose archetype contains all given component types and none of an excluded signature
+            @ function signature: void(std::size_t count, Entity* entities, Ts*... components)
+        */
+        template<typename... Ts, typename Func>
+        void ForEachChunk(const std::array<ComponentType, sizeof...(Ts)>& types, Func func, const Signature& without = Signature()){
+            // build the signature required by the query
+            Signature query;
+            for(ComponentType type : types){
+                query.set(type);
+            }
+
+            for(Archetype* archetype : archetypeList){
+                if(archetype->GetSignature().Matches(query, without)){
+                    forEachChunk<Ts...>(archetype, types, func, std::index_sequence_for<Ts...>{});
+                }
+            }
+        }
+};
+
+#endif
@@ -4,24 +4,45 @@
 #define COMPONENT_MANAGER_HPP
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
+#include <array>
 #include <iostream>
+#include <typeinfo>
+#include <type_traits>
 
 #include <ecs/types/entity.hpp>
 #include <ecs/types/component.hpp>
+#include <ecs/types/signature.hpp>
+#include <ecs/types/type_index.hpp>
 #include "ecs/types/component_array.hpp"
 
+// type-erased description of a registered component, used to save and load component data
+struct ComponentDescription{
+    // name of the component's type, used to match saved components to registered ones
+    const char* name = "";
+
+    // size of the component's data, 0 for tags
+    std::size_t size = 0;
+    std::size_t alignment = 1;
+
+    // components that aren't trivially copyable can't be saved as raw memory
+    bool triviallyCopyable = false;
+};
+
 /* Component Manager manages the interaction between
 all of the different component arrays when a component
 needs to be removed or added.
 */
 class ComponentManager{
     private:
-        // map from the type string pointer to a component type
-        std::unordered_map<const char*, ComponentType> componentTypes{};
+        // flat array from the type index of a component to its component type, UNREGISTERED_COMPONENT when not registered
+        std::vector<ComponentType> componentTypes{};
 
-        // map from the type string pointer to a component array
-        std::unordered_map<const char*, std::shared_ptr<IComponentArray>> componentArrays{};
+        // flat array from a component type to its component array
+        std::array<std::shared_ptr<IComponentArray>, MAX_COMPONENTS> componentArrays{};
+
+        // flat array from a component type to its description
+        std::array<ComponentDescription, MAX_COMPONENTS> componentDescriptions{};
 
         // the component type to be assigned to the next registered component, starting from 0
         ComponentType nextComponentType{};
@@ -29,76 +50,96 @@ class ComponentManager{
         // private storage of debug option
         char debugOption;
 
-        // helper function to get the statically caster pointer to the component array of generic type T
+        // private storage of the storage option
+        char storageOption;
+
+        // get the component type of a type index without any checks, UNREGISTERED_COMPONENT when not registered
+        ComponentType findComponentType(std::size_t index){
+            return index < componentTypes.size() ? componentTypes[index] : UNREGISTERED_COMPONENT;
+        }
+
+    public:
+        // public constructor
+        ComponentManager(char option = 'd', char storage = 's'){
+            debugOption = option;
+            storageOption = storage;
+        }
+
+        // get the statically casted pointer to the component array of generic type T
     	template<typename T>
-	    std::shared_ptr<ComponentArray<T>> GetComponentArray(){
-		    const char* typeName = typeid(T).name();
+	    ComponentArray<T>* GetComponentArray(){
+		    ComponentType type = findComponentType(TypeIndex<ComponentManager>::Get<T>());
 
-		    if(componentTypes.find(typeName) == componentTypes.end()){
+		    if(type == UNREGISTERED_COMPONENT){
                 //! display error
                 if(debugOption == 'd'){
-                    std::cout << "ERROR: Failed to retrieve component array of type: " << typeName << "\n";
+                    std::cout << "ERROR: Failed to retrieve component array of type: " << typeid(T).name() << "\n";
                 }
-                
+
                 return nullptr;
             }
 
-		    return std::static_pointer_cast<ComponentArray<T>>(componentArrays[typeName]);
+		    return static_cast<ComponentArray<T>*>(componentArrays[type].get());
 	    }
 
-    public:
-        // public constructor
-        ComponentManager(char option = 'd'){
-            debugOption = option;
-        }
-
         // registers a new component to be tracked
         template<typename T>
         void RegisterComponent(){
-            const char* typeName = typeid(T).name();
+            std::size_t index = TypeIndex<ComponentManager>::Get<T>();
 
-            if(debugOption == 'd' && componentTypes.find(typeName) != componentTypes.end()){
-                std::cout << "ERROR: Failed to register additional component: " << typeName << "\n";
+            if(debugOption == 'd' && findComponentType(index) != UNREGISTERED_COMPONENT){
+                std::cout << "ERROR: Failed to register additional component: " << typeid(T).name() << "\n";
                 return;
             }
 
-            // add this component type to the component type map
-            componentTypes.insert({typeName, nextComponentType});
+            if(nextComponentType >= MAX_COMPONENTS){
+                std::cout << "ERROR: Failed to register component: " << typeid(T).name() << " as the maximum amount of components are registered!\n";
+                return;
+            }
+
+            // add this component type to the component type array
+            if(index >= componentTypes.size()){
+                componentTypes.resize(index + 1, UNREGISTERED_COMPONENT);
+            }
+            componentTypes[index] = nextComponentType;
+            componentDescriptions[nextComponentType] = {typeid(T).name(), IS_TAG_COMPONENT<T> ? 0 : sizeof(T), alignof(T), std::is_trivially_copyable_v<T>};
 
-            // create a component array pointer and add it to the component arrays map
-            componentArrays.insert({typeName, std::make_shared<ComponentArray<T>>(debugOption)});
+            // create a component array pointer and add it to the component arrays, archetypes store their own components
+            if(storageOption != 'a'){
+                componentArrays[nextComponentType] = std::make_shared<ComponentArray<T>>(debugOption);
+            }
 
             // increment the value so that the next component registered will be different
             nextComponentType++;
         }
 
         /* get component type of a existing component
-        * @NOTE: iff component doesn't exist, returning value is 255 (aka garbage value)
-        */ 
+        * @NOTE: iff component doesn't exist, returning value is UNREGISTERED_COMPONENT
+        */
         template<typename T>
         ComponentType GetComponentType(){
-            const char* typeName = typeid(T).name();
+            ComponentType type = findComponentType(TypeIndex<ComponentManager>::Get<T>());
 
-            if(componentTypes.find(typeName) == componentTypes.end()){
+            if(type == UNREGISTERED_COMPONENT){
                 if(debugOption == 'd')
-                    std::cout << "WARNING: Failed to retrieve component type as component: " << typeName << " is NOT registered!\n";
-                /* 
-                    * NOTE: ComponentType is a unsigned 8 bit int is between 0-255, this returns 255 (aka garbage value) though iff 
-                    * there are exactly 255 Component types registered this might cause issues as the ECS does check for the garbage 
-                    * value of 255. HINT: Work around is to not have that many components (check for redundancy) or refactor how the 
-                    * component system works.
-                */
-                return -1;
+                    std::cout << "WARNING: Failed to retrieve component type as component: " << typeid(T).name() << " is NOT registered!\n";
+                return UNREGISTERED_COMPONENT;
             }
 
             // return this component's type
-            return componentTypes[typeName];
+            return type;
         }
 
         // add a component to the array for an entity
         template<typename T>
         void AddComponent(Entity entity, T component){
-            GetComponentArray<T>()->InsertData(entity, component);
+            GetComponentArray<T>()->InsertData(entity, std::move(component));
+        }
+
+        // construct a component in place for an entity, returns nullptr if it couldn't be added
+        template<typename T, typename... Args>
+        T* EmplaceComponent(Entity entity, Args&&... args){
+            return GetComponentArray<T>()->EmplaceData(entity, std::forward<Args>(args)...);
         }
 
         // remove a component from the array for an entity
@@ -119,15 +160,72 @@ class ComponentManager{
             return GetComponentArray<T>()->CheckData(entity);
         }
 
+        // get the amount of registered components
+        ComponentType GetComponentTypeCount(){
+            return nextComponentType;
+        }
+
+        // get the description of a registered component type
+        const ComponentDescription& GetComponentDescription(ComponentType type){
+            return componentDescriptions[type];
+        }
+
+        // get the type-erased component array of a component type, returns nullptr with archetype storage
+        IComponentArray* GetComponentArray(ComponentType type){
+            return type < nextComponentType ? componentArrays[type].get() : nullptr;
+        }
+
+        // get the address of an entity's component of given type, returns nullptr if the entity doesn't contain it
+        void* GetComponentData(Entity entity, ComponentType type){
+            if(type >= nextComponentType || componentArrays[type] == nullptr){
+                return nullptr;
+            }
+            return componentArrays[type]->GetDataPointer(entity);
+        }
+
+        // stamp an entity's component of given type as changed with the current change tick
+        void MarkChanged(Entity entity, ComponentType type){
+            if(type < nextComponentType && componentArrays[type] != nullptr){
+                componentArrays[type]->MarkChanged(entity);
+            }
+        }
+
+        // remove a component of given type from an entity, nothing happens if the entity doesn't contain it
+        void RemoveComponent(Entity entity, ComponentType type){
+            if(type < nextComponentType && componentArrays[type] != nullptr){
+                // removes the component only if the entity contains it
+                componentArrays[type]->EntityDestroyed(entity);
+            }
+        }
+
+        // give multiple entities a copy of the same component
+        template<typename T>
+        void AddComponents(const Entity* entities, size_t amount, const T& component){
+            GetComponentArray<T>()->InsertData(entities, amount, component);
+        }
+
+        /* notify the component arrays within a signature that given entity is destroyed
+         and remove attached components
+        */
+        void EntityDestroyed(Entity entity, Signature signature){
+            signature.ForEach([&](ComponentType type){
+                if(type < nextComponentType && componentArrays[type] != nullptr){
+                    componentArrays[type]->EntityDestroyed(entity);
+                }
+            });
+        }
+
         /* notify all component arrays that given entity is destroyed
          and remove attached components
         */
         void EntityDestroyed(Entity entity){
-            for(auto const& pair : componentArrays){
+            for(ComponentType type = 0; type < nextComponentType; type++){
                 // call interface of component to remove relavent component from entity
-                pair.second->EntityDestroyed(entity);
+                if(componentArrays[type] != nullptr){
+                    componentArrays[type]->EntityDestroyed(entity);
+                }
             }
         }
 };
 
-#endif
\ No newline at end of file
+#endif
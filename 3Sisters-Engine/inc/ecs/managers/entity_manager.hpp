@@ -3,42 +3,168 @@
 #ifndef ENTITY_MANAGER_HPP
 #define ENTITY_MANAGER_HPP
 
-#include <queue>
-#include <array>
-
 #include <ecs/types/entity.hpp>
 #include <ecs/types/signature.hpp>
+#include <ecs/types/paged_array.hpp>
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
 
-/* Entity Manager distribtutes entity IDs and
+// amount of handles a thread reserves from the shared pool at once
+const std::size_t ENTITY_RESERVE_BATCH = 64;
+
+/* Entity Manager distribtutes entity handles and
 keeps record of which entities are in use and
-which are not.
+which are not. Destroyed indices are recycled through
+an implicit free list stored within the entity slots,
+each recycle increases the index's generation. An index
+whose generation is used up is retired rather than wrapped,
+so stale handles can never become valid again. Handles can also be reserved from multiple threads at once,
+each thread takes a batch of handles from the free list or
+the unused indices without locking and hands them out one
+by one. Reserved handles become living entities once flushed.
 */
 class EntityManager{
     private:
-        // queue of unused entity IDs
-        std::queue<Entity> availableEntities{};
+        /* paged array of entity slots where the index corresponds to the entity index
+            @ a living entity's slot stores its current handle
+            @ a destroyed entity's slot stores the index of the next free slot and the generation its index will be recycled with
+            @ a retired slot stores NULL_ENTITY and is never handed out again
+        */
+        PagedArray<Entity> entities{};
+
+        // paged array of signatures where the index corresponds to the entity index
+        PagedArray<Signature> signatures{};
 
-        // array of signatures where the index corresponds to the entity ID
-        std::array<Signature, MAX_ENTITIES> signatures{};
+        // index of the first free slot of the implicit free list, ENTITY_INDEX_MASK when empty
+        Entity freeList = ENTITY_INDEX_MASK;
+
+        // the entity index given out when no destroyed indices can be reused, starting from 0
+        Entity nextEntity{};
 
         // total living entities, used to keep limits to how many exist
         uint32_t livingEntityCount{};
 
+        // maximum amount of entities allowed to exist simultaneously
+        Entity maxEntities;
+
+        /* handles reserved by a single thread that weren't handed out yet
+            @NOTE: returned to the free list when flushed or when the thread exits
+        */
+        struct ReserveCache{
+            EntityManager* owner = nullptr;
+            Entity handles[ENTITY_RESERVE_BATCH];
+            std::size_t count = 0;
+
+            ~ReserveCache();
+        };
+
+        // first free slot that can still be reserved, the free list from freeList up to it has been reserved
+        std::atomic<Entity> reserveHead{ENTITY_INDEX_MASK};
+
+        // next unused index that can be reserved, the indices from nextEntity up to it have been reserved
+        std::atomic<Entity> reserveNext{};
+
+        // amount of handles reserved since the last flush, including those still cached by threads
+        std::atomic<uint32_t> reservedCount{};
+
+        // guards the list of caches and orphaned handles
+        std::mutex cacheMutex{};
+
+        // caches of every thread that reserved handles from this manager
+        std::vector<ReserveCache*> caches{};
+
+        // cached handles of threads that exited before a flush
+        std::vector<Entity> orphaned{};
+
+        // reserve up to a given amount of handles into given array without locking, returns the amount reserved
+        std::size_t reserve(Entity* output, std::size_t amount);
+
+        // give a reserved handle that was never handed out back to the free list, it keeps its generation
+        void release(Entity handle);
+
+        // let reservations continue from the current free list and indices
+        void syncReservations(){
+            reserveHead.store(freeList, std::memory_order_relaxed);
+            reserveNext.store(nextEntity, std::memory_order_relaxed);
+        }
+
     public:
-        // constructor
-        EntityManager();
+        // constructor, the maximum amount of entities is capped at MAX_ENTITIES
+        EntityManager(Entity maximum = MAX_ENTITIES);
 
-        // create an entity
+        // destructor, detaches the caches of threads that still exist
+        ~EntityManager();
+
+        // create an entity, returns NULL_ENTITY when too many entities exist
         Entity CreateEntity();
 
+        /* create multiple entities into given array, returns the amount created
+            @NOTE: fewer entities than requested are created when the maximum is reached
+        */
+        std::size_t CreateEntities(Entity* output, std::size_t amount);
+
+        /* reserve an entity handle from any thread, returns NULL_ENTITY when too many entities exist
+            @NOTE: the handle refers to a living entity once FlushReserved() is called
+            !May only run at the same time as other reservations, not alongside other functions of the entity manager
+        */
+        Entity ReserveEntity();
+
+        /* turn every handed out reserved handle into a living entity and give the handles cached by threads back
+            @NOTE: does nothing when no handles are reserved, called automatically before entities are created or destroyed
+            !Must be called from a sync point, while no thread is reserving handles
+        */
+        void FlushReserved();
+
         // destroy an entity
         void DestroyEntity(Entity entity);
 
+        // check if a handle refers to a living entity
+        bool IsValid(Entity entity){
+            Entity index = GetEntityIndex(entity);
+            return index < nextEntity && entities[index] == entity;
+        }
+
         // set an existing entity their signature
         void SetSignature(Entity entity, Signature signature);
 
         // get an exiting entity's signature
         Signature GetSignature(Entity entity);
+
+        // get the amount of living entities
+        uint32_t GetLivingEntityCount(){
+            return livingEntityCount;
+        }
+
+        // get every living entity
+        std::vector<Entity> GetLivingEntities();
+
+        // get the maximum amount of entities that can be alive at once
+        Entity GetMaxEntities(){
+            return maxEntities;
+        }
+
+        // get the amount of entity slots handed out so far, living or destroyed
+        Entity GetSlotCount(){
+            return nextEntity;
+        }
+
+        // get the index of the first free slot, ENTITY_INDEX_MASK when there are none
+        Entity GetFreeList(){
+            return freeList;
+        }
+
+        // get the value of an entity slot, the slot must have been handed out
+        Entity GetSlot(Entity index){
+            return entities[index];
+        }
+
+        /* replace every entity slot with saved ones, every signature is cleared, returns false if there are too many living entities
+            @NOTE: every entity must have been destroyed beforehand
+        */
+        bool Restore(const Entity* slots, Entity slotCount, Entity freeListHead);
 };
 
-#endif
\ No newline at end of file
+#endif
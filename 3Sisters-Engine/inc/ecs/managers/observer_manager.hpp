@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef OBSERVER_MANAGER_HPP
+#define OBSERVER_MANAGER_HPP
+
+#include <array>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+#include <ecs/types/entity.hpp>
+#include <ecs/types/component.hpp>
+#include <ecs/types/signature.hpp>
+
+// events of a component that can be observed
+enum class ComponentEvent : std::uint8_t{
+    Add,
+    Remove,
+    Change
+};
+
+// amount of observable component events
+const std::size_t COMPONENT_EVENT_COUNT = 3;
+
+// a function called with an entity and the address of the component that the event happened to
+using Observer = std::function<void(Entity, void*)>;
+
+/* Observer Manager keeps record of the functions that
+are called when a component of a certain type is added to,
+removed from, or changed on an entity.
+*/
+class ObserverManager{
+    private:
+        // observers of each event for each component type
+        std::array<std::array<std::vector<Observer>, MAX_COMPONENTS>, COMPONENT_EVENT_COUNT> observers{};
+
+        // component types that have at least one observer for each event, allows skipping events nobody observes
+        std::array<Signature, COMPONENT_EVENT_COUNT> observed{};
+
+    public:
+        // add an observer for an event of a component type
+        void AddObserver(ComponentEvent event, ComponentType type, Observer observer){
+            observers[(std::size_t)event][type].push_back(std::move(observer));
+            observed[(std::size_t)event].set(type);
+        }
+
+        // get the component types that have observers for an event
+        Signature GetObserved(ComponentEvent event){
+            return observed[(std::size_t)event];
+        }
+
+        // call every observer of an event for a component type
+        void Notify(ComponentEvent event, ComponentType type, Entity entity, void* component){
+            for(Observer& observer : observers[(std::size_t)event][type]){
+                observer(entity, component);
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef RESOURCE_MANAGER_HPP
+#define RESOURCE_MANAGER_HPP
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include <ecs/types/type_index.hpp>
+
+/* Resource Manager stores global state that isn't part of
+any entity (e.g. the active camera, input state, or physics
+settings). Only a single instance of each resource type exists,
+it is kept outside of the component pools and found through the
+type's index without any search.
+*/
+class ResourceManager{
+    private:
+        // storage of a single resource, the resource can be destroyed and constructed again without moving its address
+        template<typename T>
+        struct ResourceSlot{
+            alignas(T) unsigned char storage[sizeof(T)];
+            bool constructed = false;
+
+            ~ResourceSlot(){
+                if(constructed){
+                    std::destroy_at(reinterpret_cast<T*>(storage));
+                }
+            }
+        };
+
+        // flat array from the type index of a resource to its slot, empty when the resource isn't set
+        std::vector<std::shared_ptr<void>> resources{};
+
+    public:
+        /* set the resource of type T, constructed from the given arguments
+            @NOTE: an existing resource is replaced in place so references to it stay valid, resources that can't be move assigned are destroyed and constructed again
+            !Must not be called while systems update in parallel, as systems on other threads may be reading resources
+        */
+        template<typename T, typename... Args>
+        T& SetResource(Args&&... args){
+            std::size_t index = TypeIndex<ResourceManager>::Get<T>();
+            if(index >= resources.size()){
+                resources.resize(index + 1);
+            }
+
+            if(resources[index] == nullptr){
+                resources[index] = std::make_shared<ResourceSlot<T>>();
+            }
+
+            ResourceSlot<T>& slot = *static_cast<ResourceSlot<T>*>(resources[index].get());
+            T* resource = reinterpret_cast<T*>(slot.storage);
+
+            if(slot.constructed){
+                if constexpr(std::is_move_assignable_v<T>){
+                    *resource = T(std::forward<Args>(args)...);
+                    return *resource;
+                }else{
+                    // the slot stays empty if constructing the new resource throws
+                    slot.constructed = false;
+                    std::destroy_at(resource);
+                }
+            }
+
+            resource = std::construct_at(resource, std::forward<Args>(args)...);
+            slot.constructed = true;
+            return *resource;
+        }
+
+        // get the resource of type T, nullptr when the resource isn't set
+        template<typename T>
+        T* GetResource(){
+            std::size_t index = TypeIndex<ResourceManager>::Get<T>();
+            if(index >= resources.size() || resources[index] == nullptr){
+                return nullptr;
+            }
+
+            ResourceSlot<T>& slot = *static_cast<ResourceSlot<T>*>(resources[index].get());
+            return slot.constructed ? reinterpret_cast<T*>(slot.storage) : nullptr;
+        }
+
+        // remove the resource of type T
+        template<typename T>
+        void RemoveResource(){
+            std::size_t index = TypeIndex<ResourceManager>::Get<T>();
+            if(index < resources.size()){
+                resources[index].reset();
+            }
+        }
+};
+
+#endif
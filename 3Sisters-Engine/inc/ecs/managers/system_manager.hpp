@@ -4,29 +4,167 @@
 #define SYSTEM_MANAGER_HPP
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
+#include <array>
 #include <type_traits>
 #include <iostream>
+#include <atomic>
 
 #include <ecs/types/system.hpp>
 #include <ecs/types/signature.hpp>
+#include <ecs/types/type_index.hpp>
+#include <ecs/types/thread_pool.hpp>
+
+// component types a system reads and writes, used to find which systems can run concurrently
+struct SystemAccess{
+    Signature reads;
+    Signature writes;
+
+    // systems that haven't declared their access are never run concurrently with another system
+    bool declared = false;
+};
 
 /* System Manager manages record of registered
 systems and their signatures. Each system needs
 a signature in order for the manager to add the
-appropriate entities.
+appropriate entities. Systems are updated in order
+of registration, systems that don't access the same
+components in conflicting ways can run concurrently.
 */
 class SystemManager{
     private:
-        // map from system type string pointer to a signature
-        std::unordered_map<const char*, Signature> signatures{};
+        // value of a slot that doesn't point to a registered system
+        static constexpr std::size_t unregisteredSlot = static_cast<std::size_t>(-1);
+
+        // flat array from the type index of a system to its slot within the systems and signatures
+        std::vector<std::size_t> systemSlots{};
+
+        // packed array of each registered system's signature
+        std::vector<Signature> signatures{};
+
+        // packed array of the component types each registered system's entities must not have
+        std::vector<Signature> exclusions{};
+
+        // packed array of each registered system
+        std::vector<std::shared_ptr<System>> systems{};
+
+        // slots of the systems whose signature or exclusion contains a given component type
+        std::array<std::vector<std::size_t>, MAX_COMPONENTS> componentSystems{};
+
+        // slots of the systems with an empty signature, these match every entity with any component
+        std::vector<std::size_t> emptySignatureSystems{};
+
+        // stamp of the last signature change each system was checked for, avoids checking a system twice
+        std::vector<std::uint32_t> systemStamps{};
+
+        // stamp of the current signature change
+        std::uint32_t currentStamp{};
 
-        // map from system type string pointer to a system pointer
-        std::unordered_map<const char*, std::shared_ptr<System>> systems{};
+        // packed array of each registered system's component access
+        std::vector<SystemAccess> accesses{};
+
+        // slots of the systems that have to wait on a given system as they access the same components
+        std::vector<std::vector<std::size_t>> dependents{};
+
+        // amount of earlier systems a given system has to wait on
+        std::vector<std::size_t> dependencyCounts{};
+
+        // remaining systems each system is waiting on during an update
+        std::unique_ptr<std::atomic<std::size_t>[]> remainingDependencies{};
+
+        // amount of systems that have finished during an update
+        std::atomic<std::size_t> finishedSystems{};
+
+        // set when systems or their access changed and the dependencies need to be rebuilt
+        bool scheduleDirty = true;
+
+        // private storage of the scheduler option
+        char schedulerOption = 'p';
+
+        // amount of worker threads to create, 0 uses the amount of hardware threads
+        std::size_t threadCount{};
+
+        // worker threads used to update systems concurrently, created on the first parallel update
+        std::unique_ptr<ThreadPool> threadPool{};
+
+        // rebuild which systems have to wait on each other
+        void rebuildSchedule();
+
+        // update a system and release the systems waiting on it
+        void runSystem(std::size_t slot, double deltaTime);
 
         // private storage of the debug option
         char debugOption;
 
+        // get the slot of a system type, returns the unregistered slot if the system isn't registered
+        template<typename T>
+        std::size_t findSlot(){
+            std::size_t index = TypeIndex<SystemManager>::Get<T>();
+            return index < systemSlots.size() ? systemSlots[index] : unregisteredSlot;
+        }
+
+        // rebuild the lists of systems interested in each component type
+        void rebuildComponentSystems(){
+            for(auto& list : componentSystems){
+                list.clear();
+            }
+            emptySignatureSystems.clear();
+
+            for(std::size_t slot = 0; slot < systems.size(); slot++){
+                if(signatures[slot].none()){
+                    emptySignatureSystems.push_back(slot);
+                    continue;
+                }
+
+                // gaining an excluded component removes the entity, so those types are watched as well
+                (signatures[slot] | exclusions[slot]).ForEach([&](ComponentType type){
+                    componentSystems[type].push_back(slot);
+                });
+            }
+        }
+
+        // add or remove an entity from a system depending on the entity's signature
+        void updateMembership(std::size_t slot, Entity entity, Signature entitySignature){
+            SparseSet& entities = systems[slot]->entities;
+
+            bool matching = matches(slot, entitySignature);
+            bool contained = entities.Contains(entity);
+
+            if(matching && !contained){
+                // insert entity into system
+                entities.Insert(entity);
+            }else if(!matching && contained){
+                // remove entity from system
+                entities.Remove(entity);
+            }
+        }
+
+        /* check if a signature matches a system's signature and has none of its excluded components,
+         empty system signatures match any entity that has a component
+        */
+        bool matches(std::size_t slot, const Signature& entitySignature){
+            auto const& systemSignature = signatures[slot];
+            if(systemSignature.none()){
+                return entitySignature.any() && !entitySignature.Intersects(exclusions[slot]);
+            }
+            return entitySignature.Matches(systemSignature, exclusions[slot]);
+        }
+
+        // add or remove multiple entities that share the same signature change from a system
+        void updateMembership(std::size_t slot, const Entity* entities, std::size_t amount, Signature oldSignature, Signature newSignature){
+            bool matched = matches(slot, oldSignature);
+            bool matching = matches(slot, newSignature);
+            SparseSet& set = systems[slot]->entities;
+
+            if(matching && !matched){
+                set.Insert(entities, amount);
+            }else if(!matching && matched){
+                for(std::size_t i = 0; i < amount; i++){
+                    set.Remove(entities[i]);
+                }
+            }
+        }
+
     public:
         // public constructor
         SystemManager(char option = 'd'){
@@ -38,16 +176,27 @@ class SystemManager{
         std::shared_ptr<T> RegisterSystem(){
             static_assert(std::is_base_of<System, T>::value, "ERROR: given type to register system does not inherit from System");
 
-            const char* typeName = typeid(T).name();
-
-            if(systems.find(typeName) != systems.end()){
-                std::cout << "ERROR: " << typeName << " is already registered, cannot have duplicate registrations\n";
+            if(findSlot<T>() != unregisteredSlot){
+                std::cout << "ERROR: " << typeid(T).name() << " is already registered, cannot have duplicate registrations\n";
                 return nullptr;
             }
 
+            // give the system a slot
+            std::size_t index = TypeIndex<SystemManager>::Get<T>();
+            if(index >= systemSlots.size()){
+                systemSlots.resize(index + 1, unregisteredSlot);
+            }
+            systemSlots[index] = systems.size();
+
             // create a pointer to the system and return it so it can be used externally
             auto system = std::make_shared<T>();
-            systems.insert({typeName, system});
+            systems.push_back(system);
+            signatures.push_back(Signature());
+            exclusions.push_back(Signature());
+            systemStamps.push_back(0);
+            accesses.push_back(SystemAccess());
+            rebuildComponentSystems();
+            scheduleDirty = true;
             return system;
         }
 
@@ -56,53 +205,159 @@ class SystemManager{
         std::shared_ptr<T> GetSystem(){
             static_assert(std::is_base_of<System, T>::value, "ERROR: given type to register system does not inherit from System");
 
-            const char* typeName = typeid(T).name();
+            std::size_t slot = findSlot<T>();
 
-            if(systems.find(typeName) == systems.end()){
-                std::cout << "ERROR: " << typeName << " is not registered, given system type can't be found\n";
+            if(slot == unregisteredSlot){
+                std::cout << "ERROR: " << typeid(T).name() << " is not registered, given system type can't be found\n";
                 // no registered system was found, return nothing
                 return nullptr;
             }
-            
-            return std::dynamic_pointer_cast<T>(systems[typeName]);
+
+            return std::static_pointer_cast<T>(systems[slot]);
         }
 
         // set the signature to specified system
         template<typename T>
         void SetSignature(Signature signature){
-            const char* typeName = typeid(T).name();
+            std::size_t slot = findSlot<T>();
 
-            if(debugOption == 'd' && systems.find(typeName) == systems.end()){
-                std::cout << "ERROR: System: " << typeName << " already contains a signature\n";
+            if(slot == unregisteredSlot){
+                if(debugOption == 'd')
+                    std::cout << "ERROR: System: " << typeid(T).name() << " is not registered, can't set its signature\n";
                 return;
             }
 
             // set the signature for this system
-            signatures.insert({typeName, signature});
+            signatures[slot] = signature;
+            rebuildComponentSystems();
+        }
+
+        // set the component types that entities of a specified system must not have
+        template<typename T>
+        void SetExclusion(Signature exclusion){
+            std::size_t slot = findSlot<T>();
+
+            if(slot == unregisteredSlot){
+                if(debugOption == 'd')
+                    std::cout << "ERROR: System: " << typeid(T).name() << " is not registered, can't set its exclusion\n";
+                return;
+            }
+
+            exclusions[slot] = exclusion;
+            rebuildComponentSystems();
         }
 
-        // remove destroyed entity from all systems
-        void EntityDestroyed(Entity entity){
-            for(auto const& pair : systems){
-                pair.second->entities.erase(entity);
+        // set the component types that a system reads and writes during its update
+        template<typename T>
+        void SetAccess(Signature reads, Signature writes){
+            std::size_t slot = findSlot<T>();
+
+            if(slot == unregisteredSlot){
+                if(debugOption == 'd')
+                    std::cout << "ERROR: System: " << typeid(T).name() << " is not registered, can't set its access\n";
+                return;
             }
+
+            accesses[slot] = {reads, writes, true};
+            scheduleDirty = true;
         }
 
-        // notify each system that a entity's signature has changed
-        void EntitySignatureChange(Entity entity, Signature entitySignature){
-            for(auto const& pair : systems){
-                auto const& type = pair.first;
-                auto const& system = pair.second;
-                auto const& systemSignature = signatures[type];
-
-                // check if the entity signature change needs to be added or removed
-                if((entitySignature & systemSignature) == systemSignature){
-                    // insert entity into system
-                    system->entities.insert(entity);
-                }else{
-                    // remove entity from system
-                    system->entities.erase(entity);
+        /* set how systems are updated
+            @ p - parallel, systems run concurrently on a thread pool when they don't access the same components (default).
+            @ s - serial, systems run one after another in order of registration on the calling thread, fully deterministic.
+            and the amount of worker threads for the parallel option, 0 uses the amount of hardware threads
+        */
+        void SetScheduler(char option, std::size_t threads = 0);
+
+        /* update every registered system, returns once every system has finished
+            @NOTE: systems that access the same components always run in order of registration
+        */
+        void UpdateSystems(double deltaTime);
+
+        /* notify the systems that multiple entities changed from the same old signature to the same new
+         signature, each system is checked once for the whole batch
+        */
+        void EntitiesSignatureChange(const Entity* entities, std::size_t amount, Signature oldSignature, Signature newSignature){
+            Signature changed = oldSignature ^ newSignature;
+            if(changed.none() || amount == 0){
+                return;
+            }
+
+            currentStamp++;
+
+            changed.ForEach([&](ComponentType type){
+                for(std::size_t slot : componentSystems[type]){
+                    if(systemStamps[slot] != currentStamp){
+                        systemStamps[slot] = currentStamp;
+                        updateMembership(slot, entities, amount, oldSignature, newSignature);
+                    }
                 }
+            });
+
+            for(std::size_t slot : emptySignatureSystems){
+                updateMembership(slot, entities, amount, oldSignature, newSignature);
+            }
+        }
+
+        /* remove multiple destroyed entities from all systems that contain them, the given
+         signature must contain every component of the destroyed entities
+        */
+        void EntitiesDestroyed(const Entity* entities, std::size_t amount, Signature combinedSignature){
+            currentStamp++;
+
+            auto removeEntities = [&](std::size_t slot){
+                SparseSet& set = systems[slot]->entities;
+                for(std::size_t i = 0; i < amount; i++){
+                    if(set.Contains(entities[i])){
+                        set.Remove(entities[i]);
+                    }
+                }
+            };
+
+            combinedSignature.ForEach([&](ComponentType type){
+                for(std::size_t slot : componentSystems[type]){
+                    if(systemStamps[slot] != currentStamp){
+                        systemStamps[slot] = currentStamp;
+                        removeEntities(slot);
+                    }
+                }
+            });
+
+            if(combinedSignature.any()){
+                for(std::size_t slot : emptySignatureSystems){
+                    removeEntities(slot);
+                }
+            }
+        }
+
+        // remove destroyed entity from all systems that contain it
+        void EntityDestroyed(Entity entity, Signature entitySignature){
+            EntitySignatureChange(entity, entitySignature, Signature());
+        }
+
+        /* notify the systems that a entity's signature has changed, only systems
+         whose signature contains a changed component type are checked
+        */
+        void EntitySignatureChange(Entity entity, Signature oldSignature, Signature newSignature){
+            Signature changed = oldSignature ^ newSignature;
+            if(changed.none()){
+                return;
+            }
+
+            currentStamp++;
+
+            // check every system interested in a changed component type once
+            changed.ForEach([&](ComponentType type){
+                for(std::size_t slot : componentSystems[type]){
+                    if(systemStamps[slot] != currentStamp){
+                        systemStamps[slot] = currentStamp;
+                        updateMembership(slot, entity, newSignature);
+                    }
+                }
+            });
+
+            for(std::size_t slot : emptySignatureSystems){
+                updateMembership(slot, entity, newSignature);
             }
         }
 };
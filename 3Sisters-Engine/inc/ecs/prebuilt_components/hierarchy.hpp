@@ -0,0 +1,16 @@
+#pragma once
+
+#ifndef HIERARCHY_HPP
+#define HIERARCHY_HPP
+
+// include entity
+#include <ecs/types/entity.hpp>
+
+/* parent component, places an entity's transform relative to the parent's transform
+    @NOTE: changing the parent has to be marked with ECS::MarkChanged<Parent>() or done through ECS::Patch<Parent>()
+*/
+struct Parent{
+    Entity entity = NULL_ENTITY;
+};
+
+#endif
@@ -9,7 +9,9 @@
 // include standard array library
 #include <array>
 
-// 2D material component
+/* 2D material component
+    @NOTE: sprites that use the same material can share a single copy through Shared<Material2D>, see shared.hpp
+*/
 struct Material2D {
     int texIndex;
     std::array<glm::vec2, 4> texCoords = {{
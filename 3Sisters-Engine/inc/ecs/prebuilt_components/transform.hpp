@@ -13,11 +13,23 @@ struct Transform{
     glm::vec3 size;
 };
 
-// 2D transform component
+// 2D transform component, relative to the parent when the entity has a Parent component
 struct Transform2D{
     glm::vec2 position;
     float rotation;
     glm::vec2 size;
 };
 
+/* cached world space 2D transform component, kept up to date by the TransformSystem
+    @NOTE: the size isn't inherited from parents, only position and rotation are
+*/
+struct WorldTransform2D{
+    glm::vec2 position = glm::vec2(0.0f);
+    float rotation = 0.0f;
+    glm::vec2 size = glm::vec2(1.0f);
+
+    // model matrix built from the world position, rotation, and size, ready to transform quad vertices
+    glm::mat4 matrix = glm::mat4(1.0f);
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef TRANSFORM_SYSTEM_HPP
+#define TRANSFORM_SYSTEM_HPP
+
+#include <vector>
+#include <cstdint>
+
+// include ECS and the components the system uses
+#include <ecs/ecs.hpp>
+#include <ecs/prebuilt_components/transform.hpp>
+#include <ecs/prebuilt_components/hierarchy.hpp>
+
+/* Transform System propagates 2D transforms down entity hierarchies
+into the cached WorldTransform2D component. Entities with both a
+Transform2D and a WorldTransform2D are stored in contiguous arrays
+sorted by their depth, so parents are always updated before their
+children. Only entities whose Transform2D changed, and the subtrees
+below them, are recomputed.
+    @ usage: ECS::RegisterComponent<Transform2D>(); ECS::RegisterComponent<WorldTransform2D>(); ECS::RegisterComponent<Parent>();
+    auto transforms = ECS::RegisterSystem<TransformSystem>(); transforms->Init(); then every frame ECS::UpdateSystems(deltaTime);
+    @NOTE: Transform2D changes must be marked with ECS::MarkChanged<Transform2D>() or done through ECS::Patch<Transform2D>()
+    @NOTE: the system advances the change tick itself, so it can also be updated directly with transforms->Update(deltaTime)
+*/
+class TransformSystem : public System{
+    private:
+        // value of a parent slot when the entity has no parent within the hierarchy
+        static constexpr std::uint32_t noParent = static_cast<std::uint32_t>(-1);
+
+        // maps an entity to its index within the depth sorted arrays
+        SparseSet order{};
+
+        // index of each entity's parent, noParent for roots
+        std::vector<std::uint32_t> parents{};
+
+        // cached world transforms, kept to compose children without looking up their parents
+        std::vector<WorldTransform2D> worlds{};
+
+        // entities that need to be recomputed this update
+        std::vector<std::uint8_t> dirty{};
+
+        // set when entities joined or left the system or a parent changed, the arrays are rebuilt, joins and leaves are observed
+        bool hierarchyChanged = true;
+
+        // change tick advanced to by the last update, changes at or after it are picked up by the next update
+        std::uint32_t lastTick{};
+
+        // rebuild the depth sorted arrays, marks every entity as dirty
+        void rebuild();
+
+        // compute the world transform of an entity at a given index from its local transform
+        void compute(std::uint32_t index, const Transform2D& local);
+
+    public:
+        /* set the system's signature and access, and start listening for hierarchy changes and entities joining or leaving
+            @NOTE: Transform2D, WorldTransform2D, and Parent must be registered beforehand
+        */
+        void Init();
+
+        // recompute the world transforms of changed entities and their children
+        void Update(double deltaTime) override;
+};
+
+#endif
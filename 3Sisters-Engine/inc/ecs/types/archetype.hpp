@@ -0,0 +1,255 @@
+#pragma once
+
+#ifndef ARCHETYPE_HPP
+#define ARCHETYPE_HPP
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include <ecs/types/entity.hpp>
+#include <ecs/types/component.hpp>
+#include <ecs/types/signature.hpp>
+#include <ecs/types/change_tick.hpp>
+
+// size in bytes of a single archetype chunk
+const std::size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+/* Component Info stores the type-erased information needed
+to place, move, and destroy a component inside of raw memory
+*/
+struct ComponentInfo{
+    std::size_t size = 0;
+    std::size_t alignment = 1;
+
+    // move constructs a component from source into uninitialized destination
+    void (*moveConstruct)(void* destination, void* source) = nullptr;
+
+    // calls the destructor of a component
+    void (*destroy)(void* data) = nullptr;
+
+    // instance shared by every entity of a tag component, nullptr for components with data as tags get no column
+    void* tagInstance = nullptr;
+
+    // create the info of a given component type
+    template<typename T>
+    static ComponentInfo Create(){
+        ComponentInfo info;
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.moveConstruct = [](void* destination, void* source){
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        };
+        info.destroy = [](void* data){
+            static_cast<T*>(data)->~T();
+        };
+
+        if constexpr(IS_TAG_COMPONENT<T>){
+            info.size = 0;
+            info.tagInstance = &GetTagInstance<T>();
+        }
+        return info;
+    }
+};
+
+/* Archetype stores every entity that shares the exact same
+signature. Entities are stored in fixed size chunks where each
+chunk holds one packed column per component (SoA), so iterating
+the components of an archetype streams linearly through memory.
+Rows are kept dense across all chunks by filling removed rows
+with the last row of the archetype. Each column is followed by
+a column of change ticks, and every chunk keeps the newest tick
+of each column so unchanged chunks can be skipped entirely.
+Empty chunks at the end are freed as the archetype shrinks,
+keeping a single spare chunk.
+*/
+class Archetype{
+    private:
+        // signature shared by every entity within the archetype
+        Signature signature;
+
+        // component type and info of each column, ordered by component type
+        std::vector<ComponentType> columnTypes{};
+        std::vector<ComponentInfo> columnInfos{};
+
+        // byte offset of each column from the start of a chunk
+        std::vector<std::size_t> columnOffsets{};
+
+        // byte offset of each column's change ticks from the start of a chunk
+        std::vector<std::size_t> tickOffsets{};
+
+        // newest change tick of each column within each chunk, indexed by chunk * columns + column
+        std::vector<std::uint32_t> chunkTicks{};
+
+        // maps a component type to its column, -1 when the archetype doesn't contain it
+        std::array<int, MAX_COMPONENTS> columnIndices{};
+
+        // allocated chunks of raw memory
+        std::vector<std::byte*> chunks{};
+
+        // amount of rows a single chunk holds
+        std::size_t chunkCapacity{};
+
+        // amount of bytes allocated for a single chunk
+        std::size_t chunkBytes{};
+
+        // alignment of every allocated chunk, at least a cache line or the largest alignment of a component
+        std::size_t chunkAlignment{};
+
+        // total amount of rows in use
+        std::size_t count{};
+
+        // get the raw address of a column's element at a given row
+        void* getAddress(std::size_t column, std::size_t row){
+            return chunks[row / chunkCapacity] + columnOffsets[column] + (row % chunkCapacity) * columnInfos[column].size;
+        }
+
+        // get the address of the entity stored at a given row
+        Entity* getEntityAddress(std::size_t row){
+            return reinterpret_cast<Entity*>(chunks[row / chunkCapacity]) + (row % chunkCapacity);
+        }
+
+        // get the address of a column's change tick at a given row
+        std::uint32_t* getTickAddress(std::size_t column, std::size_t row){
+            return reinterpret_cast<std::uint32_t*>(chunks[row / chunkCapacity] + tickOffsets[column]) + (row % chunkCapacity);
+        }
+
+        // stamp a range of rows of a column with a change tick, the rows must be within one chunk
+        void setTicks(std::size_t column, std::size_t row, std::size_t amount, std::uint32_t tick);
+
+        // allocate another chunk
+        void allocateChunk();
+
+        // free the empty chunks at the end, keeping a single spare
+        void releaseChunks();
+
+    public:
+        // constructor, requires the signature and the info of every component in the signature
+        Archetype(Signature signature, const std::vector<std::pair<ComponentType, ComponentInfo>>& components);
+
+        // destroys all remaining components and frees the chunks
+        ~Archetype();
+
+        // archetypes own raw memory, disallow copies
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /* add an entity at the end of the archetype, returns the entity's row
+            @NOTE: components of the new row are left unconstructed and must be constructed by the caller
+        */
+        std::size_t PushEntity(Entity entity);
+
+        /* add multiple entities at the end of the archetype, returns the row of the first entity
+            @NOTE: components of the new rows are left unconstructed and must be constructed by the caller
+        */
+        std::size_t PushEntities(const Entity* entities, std::size_t amount);
+
+        /* destroy the components at a given row and fill the hole with the last row
+            @NOTE: the entity previously at the last row now lives at the given row
+        */
+        void RemoveRow(std::size_t row);
+
+        /* move an entity's row into another archetype, components that the destination
+            doesn't contain are destroyed, returns the row within the destination
+            @NOTE: components the destination has that this archetype doesn't are left unconstructed
+        */
+        std::size_t MoveRow(std::size_t row, Archetype& destination);
+
+        // get the signature of the archetype
+        Signature GetSignature(){
+            return signature;
+        }
+
+        // check if the archetype has a column for a given component type, tags have no column
+        bool HasComponent(ComponentType type){
+            return columnIndices[type] != -1;
+        }
+
+        // get the address of a component at a given row, returns nullptr if the archetype doesn't contain it
+        void* GetComponent(ComponentType type, std::size_t row){
+            int column = columnIndices[type];
+            if(column == -1){
+                return nullptr;
+            }
+            return getAddress(column, row);
+        }
+
+        // get the entity at a given row
+        Entity GetEntity(std::size_t row){
+            return *getEntityAddress(row);
+        }
+
+        // stamp a range of rows of a component type with a change tick
+        void MarkChanged(ComponentType type, std::size_t row, std::uint32_t tick, std::size_t amount = 1);
+
+        // get the change tick of a component at a given row, returns 0 if the archetype doesn't contain it
+        std::uint32_t GetChangeTick(ComponentType type, std::size_t row){
+            int column = columnIndices[type];
+            if(column == -1){
+                return 0;
+            }
+            return *getTickAddress(column, row);
+        }
+
+        // get the amount of entities stored
+        std::size_t Size(){
+            return count;
+        }
+
+        //* chunk functions
+
+        // get the amount of allocated chunks
+        std::size_t GetChunkCount(){
+            return chunks.size();
+        }
+
+        // get the amount of rows a single chunk can hold
+        std::size_t GetChunkCapacity(){
+            return chunkCapacity;
+        }
+
+        // get the amount of rows in use within a given chunk
+        std::size_t GetChunkSize(std::size_t chunk){
+            std::size_t start = chunk * chunkCapacity;
+            if(count <= start){
+                return 0;
+            }
+            return (count - start) < chunkCapacity ? (count - start) : chunkCapacity;
+        }
+
+        // get the packed entity column of a given chunk
+        Entity* GetChunkEntities(std::size_t chunk){
+            return reinterpret_cast<Entity*>(chunks[chunk]);
+        }
+
+        // get the packed column of a component type within a given chunk, returns nullptr if the archetype doesn't contain it
+        void* GetChunkColumn(ComponentType type, std::size_t chunk){
+            int column = columnIndices[type];
+            if(column == -1){
+                return nullptr;
+            }
+            return chunks[chunk] + columnOffsets[column];
+        }
+
+        // get the packed change ticks of a component type within a given chunk, returns nullptr if the archetype doesn't contain it
+        std::uint32_t* GetChunkChangeTicks(ComponentType type, std::size_t chunk){
+            int column = columnIndices[type];
+            if(column == -1){
+                return nullptr;
+            }
+            return reinterpret_cast<std::uint32_t*>(chunks[chunk] + tickOffsets[column]);
+        }
+
+        // get the newest change tick of a component type within a given chunk, returns 0 if the archetype doesn't contain it
+        std::uint32_t GetChunkChangeTick(ComponentType type, std::size_t chunk){
+            int column = columnIndices[type];
+            if(column == -1){
+                return 0;
+            }
+            return chunkTicks[chunk * columnTypes.size() + column];
+        }
+};
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef CHANGE_TICK_HPP
+#define CHANGE_TICK_HPP
+
+// include standard library
+#include <cstdint>
+#include <atomic>
+
+/* Change Tick is a global counter that every added or changed
+component is stamped with. A consumer advances the tick before
+looking for changes and remembers the returned value, any component
+stamped at or after that value has changed since it last looked.
+Comparisons handle the counter wrapping around.
+*/
+class ChangeTick{
+    private:
+        // the tick new changes are stamped with
+        static inline std::atomic<std::uint32_t> current{1};
+
+    public:
+        // get the tick new changes are stamped with
+        static std::uint32_t Get(){
+            return current.load(std::memory_order_relaxed);
+        }
+
+        // advance the tick, returns the new tick
+        static std::uint32_t Advance(){
+            return current.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        // check if a stamped tick is at or after a given tick
+        static bool IsNewer(std::uint32_t tick, std::uint32_t since){
+            return static_cast<std::int32_t>(tick - since) >= 0;
+        }
+};
+
+#endif
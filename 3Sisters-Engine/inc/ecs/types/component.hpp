@@ -5,11 +5,40 @@
 
 // include standard library
 #include <cstdint>
+#include <type_traits>
 
 // type alias to define a component type
-using ComponentType = std::uint8_t;
+using ComponentType = std::uint16_t;
 
-// used to define the maximum amount of components
-const ComponentType MAX_COMPONENTS = 32;
+// component type returned for components that aren't registered
+const ComponentType UNREGISTERED_COMPONENT = static_cast<ComponentType>(-1);
 
-#endif
\ No newline at end of file
+/* used to define the maximum amount of components, signatures grow in steps of 64 bits to fit them
+ @ can be overriden at compile time by defining SISTERS_MAX_COMPONENTS (e.g. 64, 128, or 256)
+ !It sets the layout of every signature, so the engine and the game must use the same value,
+ the CMake cache variable SISTERS_MAX_COMPONENTS passes it on to everything linking the engine
+*/
+#ifndef SISTERS_MAX_COMPONENTS
+#define SISTERS_MAX_COMPONENTS 128
+#endif
+
+static_assert(SISTERS_MAX_COMPONENTS > 0 && SISTERS_MAX_COMPONENTS < UNREGISTERED_COMPONENT, "ERROR: SISTERS_MAX_COMPONENTS doesn't fit within a component type");
+
+const ComponentType MAX_COMPONENTS = SISTERS_MAX_COMPONENTS;
+
+/* components without any data (e.g. struct Enemy{};) are tags, no component data or change ticks are stored for them
+ @NOTE: with archetype storage tags only exist as a bit of the archetype's signature
+*/
+template<typename T>
+constexpr bool IS_TAG_COMPONENT = std::is_empty_v<T>;
+
+/* get the instance shared by every entity that has a given tag,
+ tags hold no data so a single instance can stand in for all of them
+*/
+template<typename T>
+T& GetTagInstance(){
+    static T instance{};
+    return instance;
+}
+
+#endif
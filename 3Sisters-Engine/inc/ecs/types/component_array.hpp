@@ -4,15 +4,19 @@
 #ifndef COMPONENT_ARRAY_HPP
 #define COMPONENT_ARRAY_HPP
 
-#include <unordered_map>
-#include <array>
+#include <vector>
 #include <cstddef>
+#include <utility>
+#include <type_traits>
 #include <iostream>
 #include <stdexcept>
 
 #include <ecs/types/entity.hpp>
+#include <ecs/types/component.hpp>
+#include <ecs/types/sparse_set.hpp>
+#include <ecs/types/change_tick.hpp>
 
-/* an interface so that the Component Mananger can tell 
+/* an interface so that the Component Mananger can tell
 a generic ComponentArray that an Entity has been destroyed
 and that it needs to update its array mappings
 */
@@ -20,108 +24,269 @@ class IComponentArray{
     public:
         virtual ~IComponentArray() = default;
         virtual void EntityDestroyed(Entity entity) = 0;
+
+        // get the amount of entities that contain the component
+        virtual size_t Size() = 0;
+
+        // get the entity stored at a given packed index
+        virtual Entity GetEntity(size_t index) = 0;
+
+        // get the packed array of entities that contain the component
+        virtual const Entity* GetEntities() = 0;
+
+        // get the address of an entity's component, returns nullptr if the entity doesn't contain it
+        virtual void* GetDataPointer(Entity entity) = 0;
+
+        // check if entity contains the component
+        virtual bool CheckData(Entity entity) = 0;
+
+        // stamp an entity's component as changed with the current change tick
+        virtual void MarkChanged(Entity entity) = 0;
+
+        // get the packed array of components as raw memory
+        virtual const void* GetRawComponents() = 0;
+
+        /* give multiple entities components copied from raw memory, returns false if the component isn't trivially copyable
+            @NOTE: the entities must not already contain the component
+        */
+        virtual bool InsertRaw(const Entity* entities, size_t amount, const void* components) = 0;
 };
 
-//TODO: remove the interface in favor of a event system that 
+//TODO: remove the interface in favor of a event system that
 // allows EntityDestroyed to be called to all ComponentArrays
 
 /* Component Array keeps track of entities that
-contain a specified component.
+contain a specified component. Tag components only
+keep the set of entities, every entity shares the
+tag's single instance.
 */
 template<typename T>
 class ComponentArray : public IComponentArray{
     private:
-        /* packed array of components, set to a specific maximum amount
-        that are mathcing the maximum number of entities allowed to exist
-        simultaneously, so that each entity has a unique spot
+        /* sparse set of the entities that contain the component, the packed
+        index of an entity within the set is the index of its component
         */
-        std::array<T, MAX_ENTITIES> componentArray{};
+        SparseSet entitySet{};
 
-        // map from an entity ID to an array index
-        std::unordered_map<Entity, size_t> entityToIndexMap{};
+        // packed array of components, matches the packed entities of the set
+        std::vector<T> componentArray{};
 
-        // map from an array index to an entity ID
-        std::unordered_map<size_t, Entity> indexToEntityMap{};
-
-        // total size of valid entries in the array
-        size_t size{};
+        // packed array of the change tick each component was last added or changed at, matches the packed entities of the set
+        std::vector<std::uint32_t> changeTicks{};
 
         // private storage of the debug option
         char debugOption;
-        
+
     public:
         // public constructor
         ComponentArray(char option = 'd'){
             debugOption = option;
         }
 
-        // give an entity a component
+        // give an entity a component, the component is moved into the array
         void InsertData(Entity entity, T component){
-            if(debugOption == 'd' && entityToIndexMap.find(entity) != entityToIndexMap.end()){
+            EmplaceData(entity, std::move(component));
+        }
+
+        /* construct an entity's component in place from the given arguments, returns a pointer to the component
+            @NOTE: returns nullptr when the entity already contains the component in debug mode
+        */
+        template<typename... Args>
+        T* EmplaceData(Entity entity, [[maybe_unused]] Args&&... args){
+            if(debugOption == 'd' && entitySet.Contains(entity)){
                 std::cout << "ERROR: Entity already contains given component!\n";
-                return;
+                return nullptr;
+            }
+
+            // put a new entity at end and update the set, the slot may still be used by another generation of the entity
+            if(entitySet.Insert(entity) == static_cast<std::size_t>(-1)){
+                std::cout << "ERROR: Entity's slot is still used by another entity!\n";
+                return nullptr;
             }
 
-            // put a new entity at end and update the maps
-            size_t newIndex = size;
-            entityToIndexMap[entity] = newIndex;
-            indexToEntityMap[newIndex] = entity;
-            componentArray[newIndex] = component;
-            ++size;
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                changeTicks.push_back(ChangeTick::Get());
+                return &componentArray.emplace_back(std::forward<Args>(args)...);
+            }
+        }
+
+        /* give multiple entities a copy of the same component
+            @NOTE: the entities must not already contain the component
+        */
+        void InsertData(const Entity* entities, size_t amount, [[maybe_unused]] const T& component){
+            entitySet.Insert(entities, amount);
+
+            if constexpr(!IS_TAG_COMPONENT<T>){
+                changeTicks.insert(changeTicks.end(), amount, ChangeTick::Get());
+                componentArray.insert(componentArray.end(), amount, component);
+            }
         }
 
         // remove an entity's component
         void RemoveData(Entity entity){
-            if(debugOption == 'd' && entityToIndexMap.find(entity) == entityToIndexMap.end()){
+            if(debugOption == 'd' && !entitySet.Contains(entity)){
                 std::cout << "ERROR: Entity doesn't have such component to remove!\n";
                 return;
             }
 
-            // copy element at end into deleted element's place to maintain density
-            size_t indexOfRemovedEntity = entityToIndexMap[entity];
-            size_t indexOfLastElement = size - 1;
-            componentArray[indexOfRemovedEntity] = componentArray[indexOfLastElement];
-
-            // update the map to point to moved spot
-            Entity entityOfLastElement = indexToEntityMap[indexOfLastElement];
-            entityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-            indexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+            // move element at end into deleted element's place to maintain density, the moved from element is destroyed
+            size_t indexOfRemovedEntity = entitySet.Remove(entity);
 
-            entityToIndexMap.erase(entity);
-            indexToEntityMap.erase(indexOfLastElement);
-
-            --size;
+            if constexpr(!IS_TAG_COMPONENT<T>){
+                if(indexOfRemovedEntity != componentArray.size() - 1){
+                    componentArray[indexOfRemovedEntity] = std::move(componentArray.back());
+                    changeTicks[indexOfRemovedEntity] = changeTicks.back();
+                }
+                componentArray.pop_back();
+                changeTicks.pop_back();
+            }
         }
 
         // return a reference of the entity's component
         T& GetData(Entity entity){
-            if(debugOption == 'd' && entityToIndexMap.find(entity) == entityToIndexMap.end()){
+            if(debugOption == 'd' && !entitySet.Contains(entity)){
                 // get name of component being looked for
                 const char* typeName = typeid(T).name();
                 // create error message to display
                 std::string errorMSG = "ERROR: Can't find entity with component: ";
                 errorMSG += typeName;
-                
+
                 // throw an exception, throws message and crashes the program
                 throw std::invalid_argument(errorMSG);
             }
 
-            return componentArray[entityToIndexMap[entity]];
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return GetTagInstance<T>();
+            }else{
+                return componentArray[entitySet.Index(entity)];
+            }
+        }
+
+        // return a pointer of the entity's component, returns nullptr if the entity doesn't contain it
+        T* TryGetData(Entity entity){
+            if(!entitySet.Contains(entity)){
+                return nullptr;
+            }
+
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                return &componentArray[entitySet.Index(entity)];
+            }
         }
 
         // check if entity contains given component
-        bool CheckData(Entity entity){
+        bool CheckData(Entity entity) override{
             // return true if entity has been found with component, otherwise false
-            return !(entityToIndexMap.find(entity) == entityToIndexMap.end());
+            return entitySet.Contains(entity);
         }
 
         // remove an entity's component when destroyed
         void EntityDestroyed(Entity entity) override{
-            if (entityToIndexMap.find(entity) != entityToIndexMap.end()){
+            if (entitySet.Contains(entity)){
 			    RemoveData(entity);
 		    }
         }
 
+        // get the amount of entities that contain the component
+        size_t Size() override{
+            return entitySet.Size();
+        }
+
+        // get the entity stored at a given packed index
+        Entity GetEntity(size_t index) override{
+            return entitySet[index];
+        }
+
+        // get the packed array of entities that contain the component
+        const Entity* GetEntities() override{
+            return entitySet.Data();
+        }
+
+        /* get the packed array of components, matches the packed array of entities
+            @NOTE: tags return their single instance, which must not be indexed
+        */
+        T* GetComponents(){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                return componentArray.data();
+            }
+        }
+
+        // get the address of an entity's component, returns nullptr if the entity doesn't contain it
+        void* GetDataPointer(Entity entity) override{
+            return TryGetData(entity);
+        }
+
+        // get the packed array of components as raw memory, tags have no memory and return nullptr
+        const void* GetRawComponents() override{
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return nullptr;
+            }else{
+                return componentArray.data();
+            }
+        }
+
+        /* give multiple entities components copied from raw memory, returns false if the component isn't trivially copyable
+            @NOTE: the entities must not already contain the component
+        */
+        bool InsertRaw(const Entity* entities, size_t amount, const void* components) override{
+            if constexpr(IS_TAG_COMPONENT<T>){
+                entitySet.Insert(entities, amount);
+                return true;
+            }else if constexpr(std::is_trivially_copyable_v<T>){
+                const T* source = static_cast<const T*>(components);
+
+                entitySet.Insert(entities, amount);
+                changeTicks.insert(changeTicks.end(), amount, ChangeTick::Get());
+                componentArray.insert(componentArray.end(), source, source + amount);
+                return true;
+            }else{
+                return false;
+            }
+        }
+
+        // stamp an entity's component as changed with the current change tick
+        void MarkChanged(Entity entity) override{
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return;
+            }
+
+            if(entitySet.Contains(entity)){
+                changeTicks[entitySet.Index(entity)] = ChangeTick::Get();
+            }
+        }
+
+        // get the change tick an entity's component was last added or changed at, returns 0 if the entity doesn't contain it or it's a tag
+        std::uint32_t GetChangeTick(Entity entity){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return 0;
+            }
+
+            return entitySet.Contains(entity) ? changeTicks[entitySet.Index(entity)] : 0;
+        }
+
+        /* call a function on every component added or changed at or after a given change tick
+            @ function signature: void(Entity entity, T& component)
+        */
+        template<typename Func>
+        void ForEachChanged(std::uint32_t sinceTick, Func func){
+            for(size_t i = 0; i < componentArray.size(); i++){
+                if(ChangeTick::IsNewer(changeTicks[i], sinceTick)){
+                    func(entitySet[i], componentArray[i]);
+                }
+            }
+        }
+
+        // reserve space for a given amount of components
+        void Reserve(size_t capacity){
+            entitySet.Reserve(capacity);
+            componentArray.reserve(capacity);
+            changeTicks.reserve(capacity);
+        }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,276 @@
+#pragma once
+
+#ifndef COMPONENT_VIEW_HPP
+#define COMPONENT_VIEW_HPP
+
+#include <tuple>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+#include <ecs/types/entity.hpp>
+#include <ecs/types/component.hpp>
+#include <ecs/types/component_array.hpp>
+#include <ecs/types/archetype.hpp>
+
+/* Component View iterates every entity that contains all
+of the given components and none of the excluded components. The component storage is resolved
+once when the view is created, iterating yields a tuple of
+the entity and a reference to each of its components.
+With sparse storage iteration is driven by the smallest
+component array, with archetype storage iteration streams
+through the chunks of every matching archetype. Tags yield
+their single shared instance.
+!Views are meant to be short lived, adding or removing
+components while iterating invalidates the view
+*/
+template<typename... Ts>
+class ComponentView{
+    private:
+        // sparse storage, the component arrays of each component
+        std::tuple<ComponentArray<Ts>*...> pools{};
+
+        // sparse storage, the smallest component array which drives iteration
+        IComponentArray* driver = nullptr;
+
+        // sparse storage, component arrays of the excluded components
+        std::vector<IComponentArray*> excluded{};
+
+        // archetype storage, every archetype that contains all of the components
+        std::vector<Archetype*> archetypes{};
+
+        // archetype storage, the component type of each component
+        std::array<ComponentType, sizeof...(Ts)> types{};
+
+        // private storage of which storage is being iterated
+        bool archetypeStorage = false;
+
+        // get a pointer to each component of a given entity, returns false if the entity is missing any or has an excluded component
+        template<std::size_t... Is>
+        bool fetch(Entity entity, std::tuple<Ts*...>& components, std::index_sequence<Is...>){
+            if(!((std::get<Is>(components) = std::get<Is>(pools)->TryGetData(entity)) && ...)){
+                return false;
+            }
+
+            for(IComponentArray* array : excluded){
+                if(array->CheckData(entity)){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // get the column of a component within a chunk, tags have no column and give their single instance
+        template<typename T>
+        static T* column(Archetype* archetype, ComponentType type, std::size_t chunk){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return &GetTagInstance<T>();
+            }else{
+                return static_cast<T*>(archetype->GetChunkColumn(type, chunk));
+            }
+        }
+
+        // get the element of a column at a given row, every row of a tag shares the same instance
+        template<typename T>
+        static T* element(T* column, std::size_t row){
+            if constexpr(IS_TAG_COMPONENT<T>){
+                return column;
+            }else{
+                return column + row;
+            }
+        }
+
+        // call a function for every entity of a chunk
+        template<typename Func, std::size_t... Is>
+        void eachChunk(Archetype* archetype, std::size_t chunk, Func& func, std::index_sequence<Is...>){
+            std::size_t size = archetype->GetChunkSize(chunk);
+            Entity* entities = archetype->GetChunkEntities(chunk);
+            std::tuple<Ts*...> columns{column<Ts>(archetype, types[Is], chunk)...};
+
+            for(std::size_t row = 0; row < size; row++){
+                func(entities[row], *element(std::get<Is>(columns), row)...);
+            }
+        }
+
+    public:
+        // iterator used to iterate the view in a range-based for loop
+        class Iterator{
+            private:
+                // the view being iterated
+                ComponentView* view = nullptr;
+
+                // sparse storage: packed index of the driver, archetype storage: archetype index
+                std::size_t index = 0;
+
+                // archetype storage, current chunk and row within the chunk
+                std::size_t chunk = 0, row = 0, chunkSize = 0;
+
+                // current entity and its components
+                Entity entity{};
+                std::tuple<Ts*...> components{};
+
+                // archetype storage, columns of the current chunk
+                Entity* entities = nullptr;
+                std::tuple<Ts*...> columns{};
+
+                // load the columns of the current chunk
+                template<std::size_t... Is>
+                void loadChunk(std::index_sequence<Is...>){
+                    Archetype* archetype = view->archetypes[index];
+                    chunkSize = archetype->GetChunkSize(chunk);
+                    entities = archetype->GetChunkEntities(chunk);
+                    ((std::get<Is>(columns) = column<Ts>(archetype, view->types[Is], chunk)), ...);
+                }
+
+                // load the entity and components at the current row
+                template<std::size_t... Is>
+                void loadRow(std::index_sequence<Is...>){
+                    entity = entities[row];
+                    ((std::get<Is>(components) = element(std::get<Is>(columns), row)), ...);
+                }
+
+                // move forward until a valid entity is found or the end is reached
+                void settle(){
+                    if(!view->archetypeStorage){
+                        // skip entities of the driver that are missing any of the other components
+                        while(view->driver != nullptr && index < view->driver->Size()){
+                            entity = view->driver->GetEntity(index);
+                            if(view->fetch(entity, components, std::index_sequence_for<Ts...>{})){
+                                return;
+                            }
+                            index++;
+                        }
+                        return;
+                    }
+
+                    // skip empty chunks and archetypes
+                    while(index < view->archetypes.size()){
+                        if(row < chunkSize){
+                            loadRow(std::index_sequence_for<Ts...>{});
+                            return;
+                        }
+
+                        row = 0;
+                        if(chunk < view->archetypes[index]->GetChunkCount()){
+                            loadChunk(std::index_sequence_for<Ts...>{});
+                            chunk++;
+                        }else{
+                            chunk = 0;
+                            chunkSize = 0;
+                            index++;
+                        }
+                    }
+                }
+
+                // get the current entity and its components
+                template<std::size_t... Is>
+                std::tuple<Entity, Ts&...> get(std::index_sequence<Is...>) const{
+                    return std::tuple<Entity, Ts&...>(entity, *std::get<Is>(components)...);
+                }
+
+            public:
+                Iterator() = default;
+
+                // create an iterator at the beginning or end of a view
+                Iterator(ComponentView* v, bool end){
+                    view = v;
+
+                    if(end){
+                        index = view->archetypeStorage ? view->archetypes.size() : (view->driver != nullptr ? view->driver->Size() : 0);
+                        return;
+                    }
+
+                    settle();
+                }
+
+                std::tuple<Entity, Ts&...> operator*() const{
+                    return get(std::index_sequence_for<Ts...>{});
+                }
+
+                Iterator& operator++(){
+                    if(view->archetypeStorage){
+                        row++;
+                    }else{
+                        index++;
+                    }
+                    settle();
+                    return *this;
+                }
+
+                bool operator==(const Iterator& other) const{
+                    return index == other.index && chunk == other.chunk && row == other.row;
+                }
+
+                bool operator!=(const Iterator& other) const{
+                    return !(*this == other);
+                }
+        };
+
+        // create an empty view
+        ComponentView() = default;
+
+        // create a view over sparse storage, entities contained within any of the excluded arrays are skipped
+        ComponentView(std::vector<IComponentArray*> excludedArrays, ComponentArray<Ts>*... componentArrays){
+            pools = std::make_tuple(componentArrays...);
+            excluded = std::move(excludedArrays);
+
+            // drive iteration from the smallest component array
+            IComponentArray* arrays[] = {componentArrays...};
+            for(IComponentArray* array : arrays){
+                if(array == nullptr){
+                    driver = nullptr;
+                    return;
+                }
+                if(driver == nullptr || array->Size() < driver->Size()){
+                    driver = array;
+                }
+            }
+        }
+
+        // create a view over archetype storage
+        ComponentView(std::vector<Archetype*> matchingArchetypes, std::array<ComponentType, sizeof...(Ts)> componentTypes){
+            archetypes = std::move(matchingArchetypes);
+            types = componentTypes;
+            archetypeStorage = true;
+        }
+
+        Iterator begin(){
+            return Iterator(this, false);
+        }
+
+        Iterator end(){
+            return Iterator(this, true);
+        }
+
+        /* call a function for every entity of the view, faster than a range-based for loop
+            @ function signature: void(Entity entity, Ts&... components)
+        */
+        template<typename Func>
+        void Each(Func func){
+            if(archetypeStorage){
+                for(Archetype* archetype : archetypes){
+                    for(std::size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++){
+                        eachChunk(archetype, chunk, func, std::index_sequence_for<Ts...>{});
+                    }
+                }
+                return;
+            }
+
+            if(driver == nullptr){
+                return;
+            }
+
+            std::tuple<Ts*...> components;
+            const Entity* entities = driver->GetEntities();
+            std::size_t size = driver->Size();
+            for(std::size_t index = 0; index < size; index++){
+                Entity entity = entities[index];
+                if(fetch(entity, components, std::index_sequence_for<Ts...>{})){
+                    std::apply([&](Ts*... component){ func(entity, *component...); }, components);
+                }
+            }
+        }
+};
+
+#endif
@@ -6,10 +6,58 @@
 // include standard library
 #include <cstdint>
 
-// type alias to define a entity
+/* type alias to define a entity, an entity is a handle made up of
+ an index (lower bits) and a generation (upper bits). The generation
+ is increased every time an index is recycled so stale handles of
+ destroyed entities never alias newly created entities.
+ @ 32-bit handles by default: 22 index bits and 10 generation bits
+ @ define SISTERS_64BIT_ENTITIES for 64-bit handles: 32 index bits and 32 generation bits
+ !It sets the layout of every handle, so the engine and the game must agree on it,
+ the CMake option SISTERS_64BIT_ENTITIES passes it on to everything linking the engine
+*/
+#ifdef SISTERS_64BIT_ENTITIES
+using Entity = std::uint64_t;
+const Entity ENTITY_INDEX_BITS = 32;
+#else
 using Entity = std::uint32_t;
+const Entity ENTITY_INDEX_BITS = 22;
+#endif
 
-// define the maximum amount of entites
-const Entity MAX_ENTITIES = 10000;
+// mask of the index bits of an entity
+const Entity ENTITY_INDEX_MASK = (Entity(1) << ENTITY_INDEX_BITS) - 1;
 
-#endif
\ No newline at end of file
+// mask of the generation bits of an entity once shifted down
+const Entity ENTITY_GENERATION_MASK = static_cast<Entity>(-1) >> ENTITY_INDEX_BITS;
+
+// handle that never refers to a living entity
+const Entity NULL_ENTITY = static_cast<Entity>(-1);
+
+/* define the maximum amount of entities, storage grows on demand
+ so a high maximum doesn't cost memory until entities are created
+ @ can be overriden at compile time through the CMake cache variable SISTERS_MAX_ENTITIES
+ @ can be lowered at runtime through ECS::Init()
+*/
+#ifndef SISTERS_MAX_ENTITIES
+#define SISTERS_MAX_ENTITIES 1000000
+#endif
+
+const Entity MAX_ENTITIES = SISTERS_MAX_ENTITIES;
+
+static_assert(MAX_ENTITIES < ENTITY_INDEX_MASK, "ERROR: SISTERS_MAX_ENTITIES doesn't fit within the index bits of an entity");
+
+// get the index of an entity, used to index into entity storage
+inline Entity GetEntityIndex(Entity entity){
+    return entity & ENTITY_INDEX_MASK;
+}
+
+// get the generation of an entity
+inline Entity GetEntityGeneration(Entity entity){
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+// create an entity handle from an index and a generation
+inline Entity MakeEntity(Entity index, Entity generation){
+    return (index & ENTITY_INDEX_MASK) | ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS);
+}
+
+#endif
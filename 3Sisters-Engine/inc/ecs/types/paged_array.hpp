@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef PAGED_ARRAY_HPP
+#define PAGED_ARRAY_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/* Paged Array is an array indexed by entity that only allocates
+memory for the pages that are in use. Pages are never moved once
+allocated so references stay valid while the array grows, and
+unallocated elements read as a default constructed value.
+*/
+template<typename T, std::size_t PageSize = 4096>
+class PagedArray{
+    private:
+        // pages of elements, unused pages are left unallocated
+        std::vector<std::unique_ptr<T[]>> pages{};
+
+    public:
+        // get an element, allocating its page when needed
+        T& Assure(std::size_t index){
+            std::size_t page = index / PageSize;
+
+            if(page >= pages.size()){
+                pages.resize(page + 1);
+            }
+
+            if(pages[page] == nullptr){
+                pages[page] = std::make_unique<T[]>(PageSize);
+            }
+
+            return pages[page][index % PageSize];
+        }
+
+        // check if the page of an element has been allocated
+        bool Contains(std::size_t index) const{
+            std::size_t page = index / PageSize;
+            return page < pages.size() && pages[page] != nullptr;
+        }
+
+        // get a copy of an element, returns a default value if its page isn't allocated
+        T Get(std::size_t index) const{
+            return Contains(index) ? pages[index / PageSize][index % PageSize] : T();
+        }
+
+        /* get an element without any checks
+            @NOTE: the page of the element must be allocated
+        */
+        T& operator[](std::size_t index){
+            return pages[index / PageSize][index % PageSize];
+        }
+
+        // get the amount of elements the allocated pages can cover
+        std::size_t Capacity() const{
+            return pages.size() * PageSize;
+        }
+
+        // free every page
+        void Clear(){
+            pages.clear();
+        }
+};
+
+#endif
@@ -0,0 +1,231 @@
+#pragma once
+
+#ifndef SHARED_HPP
+#define SHARED_HPP
+
+// include standard library
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/* check if two values of a shared type are equal, uses operator== when
+ the type has one and otherwise compares the raw bytes of trivially copyable types
+    !The byte fallback treats values differing only in padding bytes, or in floats such as -0.0f and 0.0f, as distinct,
+    such values are still correct but aren't shared, give types with padding or floats an operator== and std::hash to share them
+*/
+template<typename T>
+bool SharedEqual(const T& a, const T& b){
+    if constexpr(std::equality_comparable<T>){
+        return a == b;
+    }else{
+        static_assert(std::is_trivially_copyable_v<T>, "ERROR: Shared components need an operator== or to be trivially copyable");
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+}
+
+/* get the hash of a value of a shared type, uses std::hash when the type
+ has one and otherwise hashes the raw bytes of trivially copyable types
+    @NOTE: the byte fallback has the same limitation as SharedEqual()
+*/
+template<typename T>
+std::size_t SharedHash(const T& value){
+    if constexpr(requires{ std::hash<T>{}(value); }){
+        return std::hash<T>{}(value);
+    }else{
+        static_assert(std::is_trivially_copyable_v<T>, "ERROR: Shared components need a std::hash specialization or to be trivially copyable");
+        return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+    }
+}
+
+/* Shared Pool keeps a single reference counted instance of
+every distinct value of a shared type. Equal values are found
+through their hash, so every shared handle of the same value
+points to the same instance.
+    @NOTE: trivially copyable types without an operator== are compared by their bytes, padding bytes must be zeroed for equal values to be shared
+*/
+template<typename T>
+class SharedPool{
+    public:
+        // a single deduplicated value
+        struct Instance{
+            T value;
+            std::size_t hash;
+            std::uint32_t references;
+        };
+
+    private:
+        // every instance in use, keyed by the hash of its value
+        std::unordered_multimap<std::size_t, std::unique_ptr<Instance>> instances{};
+
+        // guards the instances and reference counts, handles may be copied from multiple threads
+        std::mutex mutex{};
+
+    public:
+        /* get the pool of the shared type
+            @NOTE: the pool is never freed, as components stored by the ECS's static managers still release into it at exit
+        */
+        static SharedPool& Get(){
+            static SharedPool* pool = new SharedPool;
+            return *pool;
+        }
+
+        // get the instance of a value, creates it if no equal value is shared yet
+        Instance* Acquire(const T& value){
+            std::size_t hash = SharedHash(value);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto [first, last] = instances.equal_range(hash);
+            for(auto it = first; it != last; it++){
+                if(SharedEqual(it->second->value, value)){
+                    it->second->references++;
+                    return it->second.get();
+                }
+            }
+
+            auto it = instances.emplace(hash, std::make_unique<Instance>(Instance{value, hash, 1}));
+            return it->second.get();
+        }
+
+        // add a reference to an instance
+        void AddReference(Instance* instance){
+            std::lock_guard<std::mutex> lock(mutex);
+            instance->references++;
+        }
+
+        // remove a reference from an instance, the instance is destroyed once nothing references it
+        void Release(Instance* instance){
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--instance->references != 0){
+                return;
+            }
+
+            auto [first, last] = instances.equal_range(instance->hash);
+            for(auto it = first; it != last; it++){
+                if(it->second.get() == instance){
+                    instances.erase(it);
+                    return;
+                }
+            }
+        }
+
+        // get the amount of references to an instance
+        std::uint32_t GetReferences(const Instance* instance){
+            std::lock_guard<std::mutex> lock(mutex);
+            return instance->references;
+        }
+
+        // get the amount of distinct values in use
+        std::size_t Size(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return instances.size();
+        }
+};
+
+/* Shared is a component holding a handle to a deduplicated
+value, every entity given an equal value references the same
+instance instead of storing its own copy. The value is read only,
+changing it through Modify() copies it first (copy-on-write) so
+other entities referencing the old value aren't affected.
+    @ usage: ECS::AddComponent(entity, Shared<Material2D>(material));
+    @NOTE: copying a handle only adds a reference, moving it is free
+*/
+template<typename T>
+class Shared{
+    private:
+        // the referenced instance, nullptr for empty handles
+        typename SharedPool<T>::Instance* instance = nullptr;
+
+    public:
+        // constructor, creates an empty handle
+        Shared() = default;
+
+        // constructor, references the instance of an equal value, creating it if needed
+        Shared(const T& value) : instance(SharedPool<T>::Get().Acquire(value)){}
+
+        Shared(const Shared& other) : instance(other.instance){
+            if(instance != nullptr){
+                SharedPool<T>::Get().AddReference(instance);
+            }
+        }
+
+        Shared(Shared&& other) noexcept : instance(std::exchange(other.instance, nullptr)){}
+
+        Shared& operator=(Shared other) noexcept{
+            std::swap(instance, other.instance);
+            return *this;
+        }
+
+        // destructor, removes the handle's reference
+        ~Shared(){
+            if(instance != nullptr){
+                SharedPool<T>::Get().Release(instance);
+            }
+        }
+
+        // get the shared value, the handle must not be empty
+        const T& Get() const{
+            return instance->value;
+        }
+
+        const T& operator*() const{
+            return instance->value;
+        }
+
+        const T* operator->() const{
+            return &instance->value;
+        }
+
+        // check if the handle references a value
+        explicit operator bool() const{
+            return instance != nullptr;
+        }
+
+        /* change the value through a function, the changed value is then shared with any equal value
+            @ usage: handle.Modify([](Material2D& material){ material.color.a = 0.5f; });
+            @NOTE: works on a copy, other handles keep referencing the unchanged value
+            @NOTE: an empty handle starts from a default constructed value
+        */
+        template<typename Func>
+        void Modify(Func func){
+            if(instance == nullptr){
+                if constexpr(std::is_default_constructible_v<T>){
+                    T value{};
+                    func(value);
+                    *this = Shared(value);
+                }else{
+                    std::cout << "ERROR: Can't modify an empty shared handle of a type that isn't default constructible!\n";
+                }
+                return;
+            }
+
+            T value = instance->value;
+            func(value);
+            *this = Shared(value);
+        }
+
+        // get the amount of handles referencing the same value
+        std::uint32_t GetReferenceCount() const{
+            return instance != nullptr ? SharedPool<T>::Get().GetReferences(instance) : 0;
+        }
+
+        // get an identifier of the referenced value, equal for every handle of the same value
+        const void* GetId() const{
+            return instance;
+        }
+
+        // check if two handles reference the same value
+        friend bool operator==(const Shared& a, const Shared& b){
+            return a.instance == b.instance;
+        }
+};
+
+#endif
@@ -4,11 +4,238 @@
 #define SIGNATURE_HPP
 
 #include <ecs/types/component.hpp>
-#include <bitset>
 
-/* type alias to define a signature which allows for
-tracking which components and entity "has"
+// include standard library
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// pick the widest SIMD instructions available at compile time for signature matching
+#if defined(__AVX2__)
+    #define SISTERS_SIGNATURE_AVX2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SISTERS_SIGNATURE_SSE2
+    #include <emmintrin.h>
+#endif
+
+// amount of 64 bit words a signature needs to hold a bit for every component type
+const std::size_t SIGNATURE_WORDS = (MAX_COMPONENTS + 63) / 64;
+
+/* Signature tracks which components an entity "has", one bit
+per component type. The bits are stored in 64 bit words, the amount
+of words follows SISTERS_MAX_COMPONENTS (64, 128, 256, ... bits).
+Keeps the interface of std::bitset so it can be used the same way,
+and adds include/exclude matching that compares whole words at once
+with SSE2 or AVX2 when available.
 */
-using Signature = std::bitset<MAX_COMPONENTS>;
+class Signature{
+    private:
+        // the bits of the signature, bit i of word w is component type w * 64 + i
+        std::uint64_t words[SIGNATURE_WORDS]{};
+
+    public:
+        //* std::bitset interface
+
+        // set the bit of a component type to a given value
+        Signature& set(std::size_t type, bool value = true){
+            std::uint64_t bit = std::uint64_t(1) << (type % 64);
+            words[type / 64] = value ? (words[type / 64] | bit) : (words[type / 64] & ~bit);
+            return *this;
+        }
+
+        // clear the bit of a component type
+        Signature& reset(std::size_t type){
+            words[type / 64] &= ~(std::uint64_t(1) << (type % 64));
+            return *this;
+        }
+
+        // clear every bit
+        Signature& reset(){
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                words[i] = 0;
+            }
+            return *this;
+        }
+
+        // check if the bit of a component type is set
+        bool test(std::size_t type) const{
+            return (words[type / 64] >> (type % 64)) & 1;
+        }
+
+        // check if any bit is set
+        bool any() const{
+            std::uint64_t combined = 0;
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                combined |= words[i];
+            }
+            return combined != 0;
+        }
+
+        // check if no bit is set
+        bool none() const{
+            return !any();
+        }
+
+        // get the amount of set bits
+        std::size_t count() const{
+            std::size_t amount = 0;
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                amount += std::popcount(words[i]);
+            }
+            return amount;
+        }
+
+        Signature& operator&=(const Signature& other){
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                words[i] &= other.words[i];
+            }
+            return *this;
+        }
+
+        Signature& operator|=(const Signature& other){
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                words[i] |= other.words[i];
+            }
+            return *this;
+        }
+
+        Signature& operator^=(const Signature& other){
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                words[i] ^= other.words[i];
+            }
+            return *this;
+        }
+
+        Signature operator~() const{
+            Signature result;
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                result.words[i] = ~words[i];
+            }
+
+            // keep the bits past the last component type cleared
+            if constexpr(MAX_COMPONENTS % 64 != 0){
+                result.words[SIGNATURE_WORDS - 1] &= (std::uint64_t(1) << (MAX_COMPONENTS % 64)) - 1;
+            }
+            return result;
+        }
+
+        friend Signature operator&(Signature a, const Signature& b){
+            return a &= b;
+        }
+
+        friend Signature operator|(Signature a, const Signature& b){
+            return a |= b;
+        }
+
+        friend Signature operator^(Signature a, const Signature& b){
+            return a ^= b;
+        }
+
+        friend bool operator==(const Signature& a, const Signature& b){
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                if(a.words[i] != b.words[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const Signature& a, const Signature& b){
+            return !(a == b);
+        }
+
+        //* matching functions
+
+        // check if every bit of a given signature is set within this signature
+        bool Contains(const Signature& required) const{
+            return Matches(required, Signature());
+        }
+
+        // check if this signature shares any bit with a given signature
+        bool Intersects(const Signature& other) const{
+            return !Matches(Signature(), other);
+        }
+
+        /* check if this signature has every bit of an include signature and no bit of an exclude signature
+            @NOTE: compares 256 bits at a time with AVX2, 128 bits with SSE2, and 64 bits otherwise
+        */
+        bool Matches(const Signature& include, const Signature& exclude) const{
+            std::size_t i = 0;
+
+            #if defined(SISTERS_SIGNATURE_AVX2)
+            if constexpr(SIGNATURE_WORDS >= 4){
+                __m256i mismatch = _mm256_setzero_si256();
+                for(; i + 4 <= SIGNATURE_WORDS; i += 4){
+                    __m256i self = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+                    __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(include.words + i));
+                    __m256i out = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(exclude.words + i));
+
+                    // included bits that are missing, and excluded bits that are present
+                    mismatch = _mm256_or_si256(mismatch, _mm256_or_si256(_mm256_andnot_si256(self, in), _mm256_and_si256(self, out)));
+                }
+                if(!_mm256_testz_si256(mismatch, mismatch)){
+                    return false;
+                }
+            }
+            #endif
+
+            #if defined(SISTERS_SIGNATURE_AVX2) || defined(SISTERS_SIGNATURE_SSE2)
+            if constexpr(SIGNATURE_WORDS >= 2){
+                __m128i mismatch = _mm_setzero_si128();
+                for(; i + 2 <= SIGNATURE_WORDS; i += 2){
+                    __m128i self = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+                    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(include.words + i));
+                    __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(exclude.words + i));
+
+                    mismatch = _mm_or_si128(mismatch, _mm_or_si128(_mm_andnot_si128(self, in), _mm_and_si128(self, out)));
+                }
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(mismatch, _mm_setzero_si128())) != 0xFFFF){
+                    return false;
+                }
+            }
+            #endif
+
+            std::uint64_t mismatch = 0;
+            for(; i < SIGNATURE_WORDS; i++){
+                mismatch |= (include.words[i] & ~words[i]) | (exclude.words[i] & words[i]);
+            }
+            return mismatch == 0;
+        }
+
+        /* call a function with every set component type, in ascending order
+            @ function signature: void(ComponentType type)
+        */
+        template<typename Func>
+        void ForEach(Func func) const{
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                std::uint64_t word = words[i];
+                while(word != 0){
+                    func(static_cast<ComponentType>(i * 64 + std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        // get a hash of the signature, used to key archetypes by their signature
+        std::size_t Hash() const{
+            std::size_t hash = 0;
+            for(std::size_t i = 0; i < SIGNATURE_WORDS; i++){
+                hash ^= std::hash<std::uint64_t>()(words[i]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+};
+
+// allows signatures to be used as keys of unordered containers
+namespace std{
+    template<>
+    struct hash<Signature>{
+        std::size_t operator()(const Signature& signature) const{
+            return signature.Hash();
+        }
+    };
+}
 
-#endif
\ No newline at end of file
+#endif
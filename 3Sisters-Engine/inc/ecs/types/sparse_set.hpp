@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef SPARSE_SET_HPP
+#define SPARSE_SET_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <ecs/types/entity.hpp>
+
+// amount of entities covered by a single page of the sparse array
+const std::size_t SPARSE_PAGE_SIZE = 4096;
+
+/* Sparse Set stores a packed array of entities alongside
+a paged sparse array that maps an entity's index to its index
+within the packed array. Lookups, insertions, and removals are
+O(1) and pages are only allocated for ranges of entities in use.
+Removal swaps the last entity into the removed entity's place
+so the packed array stays dense. The packed array stores full
+entity handles so stale handles are never reported as contained.
+*/
+class SparseSet{
+    private:
+        // value of a sparse slot that doesn't point into the packed array
+        static constexpr Entity nullIndex = static_cast<Entity>(-1);
+
+        // pages of indices into the packed array, indexed by the index of an entity
+        std::vector<std::unique_ptr<Entity[]>> pages{};
+
+        // packed array of entities
+        std::vector<Entity> dense{};
+
+        // get the sparse slot of an entity, allocating its page when needed
+        Entity& assure(Entity entity){
+            std::size_t page = GetEntityIndex(entity) / SPARSE_PAGE_SIZE;
+
+            if(page >= pages.size()){
+                pages.resize(page + 1);
+            }
+
+            if(pages[page] == nullptr){
+                pages[page] = std::make_unique<Entity[]>(SPARSE_PAGE_SIZE);
+                for(std::size_t i = 0; i < SPARSE_PAGE_SIZE; i++){
+                    pages[page][i] = nullIndex;
+                }
+            }
+
+            return pages[page][GetEntityIndex(entity) % SPARSE_PAGE_SIZE];
+        }
+
+        // get the sparse slot of an entity without any checks
+        Entity& slot(Entity entity){
+            return pages[GetEntityIndex(entity) / SPARSE_PAGE_SIZE][GetEntityIndex(entity) % SPARSE_PAGE_SIZE];
+        }
+
+        const Entity& slot(Entity entity) const{
+            return pages[GetEntityIndex(entity) / SPARSE_PAGE_SIZE][GetEntityIndex(entity) % SPARSE_PAGE_SIZE];
+        }
+
+    public:
+        // check if the set contains a given entity
+        bool Contains(Entity entity) const{
+            std::size_t page = GetEntityIndex(entity) / SPARSE_PAGE_SIZE;
+            if(page >= pages.size() || pages[page] == nullptr){
+                return false;
+            }
+
+            // the stored handle must match to reject stale generations
+            Entity index = pages[page][GetEntityIndex(entity) % SPARSE_PAGE_SIZE];
+            return index != nullIndex && dense[index] == entity;
+        }
+
+        /* get the packed index of an entity
+            @NOTE: the entity must be contained within the set
+        */
+        std::size_t Index(Entity entity) const{
+            return slot(entity);
+        }
+
+        // get the packed index of an entity, returns -1 if the set doesn't contain it
+        std::size_t Find(Entity entity) const{
+            return Contains(entity) ? Index(entity) : static_cast<std::size_t>(-1);
+        }
+
+        /* add an entity at the end of the packed array, returns its packed index
+            @NOTE: returns -1 and leaves the set unchanged when the entity's slot is already in use, such as by another generation of the entity
+        */
+        std::size_t Insert(Entity entity){
+            Entity& index = assure(entity);
+            if(index != nullIndex){
+                return static_cast<std::size_t>(-1);
+            }
+
+            index = static_cast<Entity>(dense.size());
+            dense.push_back(entity);
+            return dense.size() - 1;
+        }
+
+        /* remove an entity by moving the last entity into its place, returns the packed index that was freed
+            @NOTE: the entity must be contained within the set
+        */
+        std::size_t Remove(Entity entity){
+            std::size_t index = Index(entity);
+            Entity last = dense.back();
+
+            dense[index] = last;
+            slot(last) = static_cast<Entity>(index);
+            slot(entity) = nullIndex;
+            dense.pop_back();
+
+            return index;
+        }
+
+        /* add multiple entities at the end of the packed array, returns the packed index of the first entity
+            @NOTE: the entities must not already be contained within the set
+        */
+        std::size_t Insert(const Entity* entities, std::size_t amount){
+            std::size_t first = dense.size();
+            dense.reserve(first + amount);
+
+            for(std::size_t i = 0; i < amount; i++){
+                assure(entities[i]) = static_cast<Entity>(first + i);
+            }
+            dense.insert(dense.end(), entities, entities + amount);
+
+            return first;
+        }
+
+        // reserve space in the packed array for a given amount of entities
+        void Reserve(std::size_t capacity){
+            dense.reserve(capacity);
+        }
+
+        // remove every entity from the set, allocated pages are kept
+        void Clear(){
+            for(Entity entity : dense){
+                slot(entity) = nullIndex;
+            }
+            dense.clear();
+        }
+
+        // get the amount of entities within the set
+        std::size_t Size() const{
+            return dense.size();
+        }
+
+        // check if the set is empty
+        bool Empty() const{
+            return dense.empty();
+        }
+
+        // get the packed array of entities
+        const Entity* Data() const{
+            return dense.data();
+        }
+
+        // get the entity at a given packed index
+        Entity operator[](std::size_t index) const{
+            return dense[index];
+        }
+
+        //* iteration functions, allows for range-based for loops
+
+        std::vector<Entity>::const_iterator begin() const{
+            return dense.begin();
+        }
+
+        std::vector<Entity>::const_iterator end() const{
+            return dense.end();
+        }
+};
+
+#endif
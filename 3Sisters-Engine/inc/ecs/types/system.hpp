@@ -3,19 +3,30 @@
 #ifndef SYSTEM_HPP
 #define SYSTEM_HPP
 
-#include <set>
-
 #include <ecs/types/entity.hpp>
+#include <ecs/types/sparse_set.hpp>
 
-/* System contains a set of entities with certain
-signatures that it can iterate through
+/* System contains a packed set of entities with certain
+signatures that it can iterate through. Systems updated
+through ECS::UpdateSystems() can run concurrently with
+other systems that access different components.
 */
 class System{
     public:
-        std::set<Entity> entities;
+        /* packed set of entities matching the system's signature
+            @ iterate with a range-based for loop: for(Entity entity : entities)
+            @ membership can be checked in O(1) with entities.Contains(entity)
+        */
+        SparseSet entities;
 
         // makes class polymorphic
         virtual ~System() = default;
+
+        /* called by ECS::UpdateSystems(), may run on a worker thread
+            @NOTE: only components declared with ECS::SetSystemAccess() should be accessed
+            !Structural changes (creating/destroying entities, adding/removing components) must be recorded within an ECS::CommandBuffer
+        */
+        virtual void Update([[maybe_unused]] double deltaTime){}
 };
 
-#endif
\ No newline at end of file
+#endif
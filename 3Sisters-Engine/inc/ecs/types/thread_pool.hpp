@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+/* Thread Pool runs tasks on a set of worker threads. Each worker
+owns a queue of tasks, tasks submitted from a worker go onto its
+own queue and workers that run out of tasks steal from the queues
+of the others. Threads outside of the pool share one extra queue
+and can help run tasks while waiting on them.
+*/
+class ThreadPool{
+    private:
+        // a queue of tasks owned by a single thread
+        struct TaskQueue{
+            std::mutex mutex{};
+            std::deque<std::function<void()>> tasks{};
+        };
+
+        // queues of each worker, the last queue is shared by threads outside of the pool
+        std::vector<std::unique_ptr<TaskQueue>> queues{};
+
+        // the worker threads
+        std::vector<std::thread> workers{};
+
+        // amount of tasks within all queues
+        std::atomic<std::size_t> pendingTasks{};
+
+        // used to put workers to sleep while there are no tasks
+        std::mutex sleepMutex{};
+        std::condition_variable wakeCondition{};
+
+        // tells workers to exit
+        bool stopping = false;
+
+        // pool and queue index of the current thread, used to find the current thread's own queue
+        static thread_local ThreadPool* currentPool;
+        static thread_local std::size_t currentQueue;
+
+        // get the queue index of the current thread
+        std::size_t queueIndex() const{
+            return currentPool == this ? currentQueue : queues.size() - 1;
+        }
+
+        // loop run by each worker thread
+        void workerLoop(std::size_t index);
+
+    public:
+        /* constructor, creates given amount of worker threads
+            @NOTE: a thread count of 0 creates a worker for each hardware thread except the calling thread
+        */
+        ThreadPool(std::size_t threadCount = 0);
+
+        // destructor, waits for the workers to finish their current task and exit
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // add a task onto the current thread's queue
+        void Submit(std::function<void()> task);
+
+        // run a single task on the current thread, stealing from other queues when needed, returns false if there were no tasks
+        bool RunPendingTask();
+
+        // run tasks on the current thread until the given predicate returns true
+        template<typename Predicate>
+        void WaitUntil(Predicate predicate){
+            while(!predicate()){
+                if(!RunPendingTask()){
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // get the amount of worker threads
+        std::size_t GetThreadCount() const{
+            return workers.size();
+        }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#ifndef TYPE_INDEX_HPP
+#define TYPE_INDEX_HPP
+
+// include standard library
+#include <cstddef>
+#include <atomic>
+
+/* Type Index hands out a unique, sequential index to every
+type it is asked about, starting from 0. Each family (e.g.
+components or systems) keeps its own counter so indices stay
+small and can be used directly as an index into a flat array.
+The index of a type is resolved once and then stays constant.
+*/
+template<typename Family>
+class TypeIndex{
+    private:
+        // get the next unused index of the family
+        static std::size_t next(){
+            static std::atomic<std::size_t> counter{0};
+            return counter++;
+        }
+
+    public:
+        // get the index of a given type
+        template<typename T>
+        static std::size_t Get(){
+            static const std::size_t index = next();
+            return index;
+        }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef QUAD_BATCH_HPP
+#define QUAD_BATCH_HPP
+
+// include GLM
+#include <glm/glm.hpp>
+
+// include standard library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// data struct of standard quad's vertex information
+struct QuadVertex{
+    glm::vec2 position;
+    glm::vec2 texCoords;
+    float texIndex;
+    glm::vec4 color;
+};
+
+/* compact description of a single quad, 32 bytes, uploaded as is by the instanced path
+    @NOTE: the rotation is stored in radians scaled to [-1, 1], texture coordinates are stored as a rectangle
+*/
+struct QuadInstance{
+    glm::vec2 position;
+    glm::vec2 size;
+    std::int16_t rotation;
+    std::uint16_t texIndex;
+    std::uint32_t color;
+    std::uint16_t texRect[4];
+
+    /* create an instance from the same raw data as QuadRenderer::StackQuad()
+        @ rotation is given in degrees, color is packed into 8 bits per channel
+        @ texRect is the bottom left (x, y) and top right (z, w) texture coordinates
+    */
+    static QuadInstance Create(int texIndex, glm::vec2 position, glm::vec2 size, float rotation, glm::vec4 color = glm::vec4(1.0f), glm::vec4 texRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+};
+
+static_assert(sizeof(QuadInstance) == 32, "ERROR: A quad instance must stay 32 bytes");
+
+/* write the four corner vertices of every given quad instance into the output, in the same order as QuadRenderer::StackQuad()
+    @NOTE: quads are loaded, rotated, and stored 4 at a time with SSE2, and one at a time otherwise
+    @NOTE: doesn't use OpenGL, so it can run without a context
+    !The output must have room for 4 vertices per instance
+*/
+void BuildQuadVertices(std::span<const QuadInstance> instances, QuadVertex* output);
+
+#endif
@@ -11,9 +11,19 @@
 // include standard array library
 #include <array>
 
+// include standard library
+#include <cstdint>
+#include <span>
+
 // include shader class
 #include <resourceSystems/resource_shader.hpp>
 
+// include quad batch building
+#include <engine/quad_batch.hpp>
+
+// include texture array class
+#include <resourceSystems/resource_texture_array.hpp>
+
 /* A static singleton Quad Rendering Class used to 
  render 2D render primatives. This class uses given raw data to 
  represent and render a 2D primative. This class utilizes 
@@ -23,8 +33,15 @@
 */
 class QuadRenderer{    
     public:
-        // initialize the quad renderer which requires a loaded shader
-        static void Init(Shader& quadShader);
+        // compact description of a single quad, see quad_batch.hpp
+        using QuadInstance = ::QuadInstance;
+
+        /* initialize the quad renderer which requires a loaded shader
+            @NOTE: the shader picks how textures are sampled, quad.frag uses up to 32 texture units, quad_array.frag a texture array and quad_bindless.frag bindless textures
+            @NOTE: with OpenGL 4.4+ quads are written straight into a persistently mapped buffer, unless persistent mapping is turned off
+            @NOTE: older contexts upload each batch into an orphaned buffer instead
+        */
+        static void Init(Shader& quadShader, bool persistentMapping = true);
 
         //* draw render primatives functions
 
@@ -39,11 +56,42 @@ class QuadRenderer{
         */
         static void StackQuad(int texIndex, glm::vec2 position, glm::vec2 size, float rotation, glm::vec4 color = glm::vec4(1.0f), const std::array<glm::vec2, 4> texCoords = textureCoordinates, const glm::vec4 vertexPositions[] = quadVertexPositions);
 
+        /* store multiple quads at once, the corners of several quads are computed together with SIMD
+            @Requires the Flush() after this function in order to render what was stored
+            @NOTE: faster than calling StackQuad() per quad, textures always use their full or given rectangle
+        */
+        static void StackQuads(std::span<const QuadInstance> quads);
+
+        //* instanced functions
+
+        /* initialize the instanced path which requires a loaded instancing shader (e.g. quad_instanced.vert with quad.frag)
+            @NOTE: requires the Init() beforehand, the instanced path shares its index buffer
+        */
+        static void InitInstancing(Shader& instanceShader);
+
+        /* store a single quad instance, expanded into its four corners on the GPU
+            @Requires the FlushQuadInstances() after this function in order to render what was stored
+        */
+        static void StackQuadInstance(const QuadInstance& instance);
+
+        // store multiple quad instances at once
+        static void StackQuadInstances(std::span<const QuadInstance> instances);
+
+        //* texture functions
+
+        /* sample the layers of a texture array, the texture index of each quad is its layer
+            @NOTE: requires shaders using the texture array (e.g. quad_array.frag), stored quads are flushed first
+        */
+        static void UseTextureArray(TextureArray& textures);
+
         //* flush functions
 
         // used to tell the GPU to render the stored quads in the buffer
         static void FlushQuads();
 
+        // used to tell the GPU to render the stored quad instances with a single instanced draw
+        static void FlushQuadInstances();
+
     private:
         // used to store default offsets of quad vertex positions
         const static glm::vec4 quadVertexPositions[];
@@ -52,12 +100,7 @@ class QuadRenderer{
         const static std::array<glm::vec2, 4>  textureCoordinates;
 
         // data struct of standard quad's vertex information
-        struct QuadVertex{
-            glm::vec2 position;
-            glm::vec2 texCoords;
-            float texIndex;
-            glm::vec4 color;
-        };
+        using QuadVertex = ::QuadVertex;
 
         // storage of the quad shader
         static Shader quadShader;
@@ -68,26 +111,77 @@ class QuadRenderer{
         // counter to track the number of vertices of quads
         static unsigned int quadIndexCount;
 
-        // stores max number of quads as a buffer
+        // stores max number of quads as a buffer, points to the start of the current batch
         static QuadVertex* quadBuffer;
 
         // stores the amount of wanted quad buffers
         static QuadVertex* quadBufferPtr;  
 
+        // end of the memory the current batch can be written into
+        static QuadVertex* quadBufferEnd;
+
         // stores the amount of quads to render
         const static int 
         maxQuadCount = 10000, 
         maxQuadVertexCount = maxQuadCount * 4, 
         maxQuadIndexCount = maxQuadCount * 6;
 
-        // stores maximum amount of textures there can be
+        //* persistent mapping
+
+        // amount of segments of the persistently mapped buffer, the GPU reads one while the CPU writes the next
+        const static int quadSegmentCount = 3;
+
+        // true when the vertex buffer is persistently mapped
+        static bool isPersistent;
+
+        // start of the persistently mapped vertex buffer, holds every segment
+        static QuadVertex* quadMapped;
+
+        // segment currently being written into
+        static int quadSegment;
+
+        // amount of vertices already written into the current segment
+        static int quadSegmentOffset;
+
+        // fences signaled once the GPU is done reading each segment
+        static GLsync quadFences[quadSegmentCount];
+
+        // stores maximum amount of textures there can be when using texture units
         const static int maxTextureSlots = 32;
+
+        /* texture unit of the texture array, the array replaces the per-slot samplers so it takes the first unit
+            @NOTE: units past 31 aren't guaranteed by OpenGL ES 3.0, and the array binds to its own target so the 2D texture on unit 0 stays bound
+        */
+        const static int textureArrayUnit = 0;
+
+        //* instancing
+
+        // storage of the instancing shader
+        static Shader instanceShader;
+
+        // stores data of the quad instances, the index buffer is shared with the quads
+        static unsigned int instanceVAO, instanceVBO;
+
+        // stores the instances of the current batch
+        static QuadInstance* instanceBuffer;
+
+        // amount of instances within the current batch
+        static int instanceCount;
         
         // private constructor 
         QuadRenderer() {}
 
         // initial setup for quad rendering, sets ups the rendering of quads and their buffer data
-        static void initQuadRenderData();
+        static void initQuadRenderData(bool persistentMapping);
+
+        // initial setup for instanced rendering, sets up the instance buffer and its attributes
+        static void initInstanceRenderData();
+
+        // set up a shader's texture samplers, depending on if it samples texture units, a texture array, or bindless textures
+        static void setUpSamplers(Shader& shader);
+
+        // move onto the next segment of the persistently mapped buffer, waits until the GPU is done reading it
+        static void nextQuadSegment();
 
         //* primative creation functions
 
@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+// include GLM
+#include <glm/glm.hpp>
+
+// include standard library
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// include quad batch building
+#include <engine/quad_batch.hpp>
+
+// include resource types
+#include <resourceSystems/resource_types.hpp>
+
+/* A static singleton Render Queue class that collects quads,
+ lines, and text from anywhere in a frame and renders them in
+ order of their layer instead of their submission. Each submission
+ gets a 64 bit sort key of its layer, shader, texture and depth, the
+ keys are radix sorted once per Flush() and the submissions are then
+ stacked into the Quad, Line, and Text Renderers, flushing only when
+ the shader or font changes. All functions and resources are static
+ and no public constructor is defined.
+    @ usage: RenderQueue::SubmitQuad(1, texIndex, position, size, rotation); ... RenderQueue::Flush();
+    @NOTE: within a layer quads are rendered before lines and lines before text, then by texture and from lowest to highest depth
+    !Requires the renderers of the submitted primatives to be initialized
+*/
+class RenderQueue{
+    public:
+        //* submit functions
+
+        /* submit a quad utilizing given raw data, layers range from -32768 to 32767
+            @NOTE: sub textures are given through their bottom left (x, y) and top right (z, w) texture coordinates
+        */
+        static void SubmitQuad(int layer, int texIndex, glm::vec2 position, glm::vec2 size, float rotation, glm::vec4 color = glm::vec4(1.0f), float depth = 0.0f, glm::vec4 texRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+        // submit an already packed quad instance
+        static void SubmitQuad(int layer, const QuadInstance& quad, float depth = 0.0f);
+
+        // submit multiple packed quad instances sharing a layer and depth
+        static void SubmitQuads(int layer, std::span<const QuadInstance> quads, float depth = 0.0f);
+
+        // submit a line from p0 to p1
+        static void SubmitLine(int layer, glm::vec2 p0, glm::vec2 p1, glm::vec4 color = glm::vec4(1.0f), float depth = 0.0f);
+
+        /* submit text using a loaded font, the z of the position is used as its depth
+            @NOTE: the font must stay loaded until Flush()
+        */
+        static void SubmitText(int layer, CharacterSet& set, std::string text, glm::vec3 position, float rotation, float size, glm::vec4 color = glm::vec4(1.0f));
+
+        //* flush functions
+
+        // sort every submission and render them, the queue is empty afterwards
+        static void Flush();
+
+        //* getter functions
+
+        // retrieve the amount of submissions waiting for Flush()
+        static std::size_t GetSubmissionCount();
+
+    private:
+        // kinds of submissions, also their order within a layer since each uses its own shader
+        enum Kind : std::uint8_t{
+            KIND_QUAD = 0,
+            KIND_LINE = 1,
+            KIND_TEXT = 2
+        };
+
+        // a sort key along with the index of its submission within the storage of its kind
+        struct SortEntry{
+            std::uint64_t key;
+            std::uint32_t index;
+        };
+
+        // data of a submitted line
+        struct LineSubmission{
+            glm::vec2 p0, p1;
+            glm::vec4 color;
+        };
+
+        // data of submitted text
+        struct TextSubmission{
+            CharacterSet* set;
+            std::string text;
+            glm::vec3 position;
+            float rotation;
+            float size;
+            glm::vec4 color;
+        };
+
+        // sort keys of every submission
+        static std::vector<SortEntry> entries;
+
+        // used as the second buffer of the radix sort
+        static std::vector<SortEntry> sortBuffer;
+
+        // submissions of each kind
+        static std::vector<QuadInstance> quads;
+        static std::vector<LineSubmission> lines;
+        static std::vector<TextSubmission> texts;
+
+        // fonts submitted since the last flush, their position is the font's texture within the sort key
+        static std::vector<CharacterSet*> fonts;
+
+        // used to gather consecutive quads so they're stacked at once
+        static std::vector<QuadInstance> quadRun;
+
+        // private constructor
+        RenderQueue() {}
+
+        // bit offsets of the fields of a sort key, from the top: 16 bits layer, 8 bits kind, 16 bits texture, 24 bits depth
+        static constexpr int layerShift = 48;
+        static constexpr int kindShift = 40;
+        static constexpr int textureShift = 24;
+
+        // create a sort key, ordered by layer, kind, texture and then depth
+        static std::uint64_t createKey(int layer, Kind kind, std::uint32_t texture, float depth);
+
+        // get the kind of a sort key
+        static Kind kindOf(std::uint64_t key);
+
+        // sort the entries by their keys, keeps the submission order of equal keys
+        static void sortEntries();
+
+        // flush the renderer of a kind
+        static void flushKind(Kind kind);
+};
+
+#endif
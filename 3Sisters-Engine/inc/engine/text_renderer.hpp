@@ -36,7 +36,7 @@ class TextRenderer{
         
         /* used to draw text on the screen using a loaded font
             @ Recommended to use a CharacterSet loaded through from the ResourceManager
-            !If using multiple fonts, stack and flush for each particular font being used, you can't mix different fonts when stacking
+            @NOTE: a batch holds a single font, stacking another font flushes the previous font's characters first
         */
         static void StackCharacters(CharacterSet& set, std::string text, glm::vec3 position, float rotation, float size, glm::vec4 color = glm::vec4(1.0f));
         
@@ -72,6 +72,17 @@ class TextRenderer{
         
         // stores the amount of wanted character quads
         static CharacterVertex* characterVertexBufferPtr; 
+
+        // font of the current batch
+        static CharacterSet* characterSet;
+
+        // amount of texture units used by the quad renderer's textures, the fonts go after them when possible
+        const static int quadTextureUnits = 32;
+
+        /* texture unit of the fonts, picked by Init() from the amount of texture units available
+            @NOTE: OpenGL ES 3.0 only guarantees 32 units, then the last one is shared with the quad renderer's last texture
+        */
+        static int fontTextureUnit;
         
         // stores the amount of quads to render
         const static int 
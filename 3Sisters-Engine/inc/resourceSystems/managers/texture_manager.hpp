@@ -12,6 +12,7 @@
 
 // include necessary classes such as texture and shader classes
 #include <resourceSystems/resource_texture.hpp>
+#include <resourceSystems/resource_texture_array.hpp>
 
 // include resource definitions
 #include <resourceSystems/resource_types.hpp>
@@ -43,6 +44,31 @@ class TextureManager{
         // create a white texture that is named "default"
         static void GenerateWhiteTexture();
 
+        //* texture array functions
+
+        /* creates an empty texture array of same-size layers along with a name and optional texture filter option
+        * @NOTE: textures are loaded into its layers with LoadTextureLayer()
+        * @NOTE: used with QuadRenderer::UseTextureArray() and the quad_array shader, a quad's texture index is then its layer
+        */
+        static TextureArray& CreateTextureArray(std::string name, unsigned int width, unsigned int height, unsigned int layers, bool linearFilter = false);
+
+        /* loads a texture from file into the next free layer of a texture array along with a name, returns the layer or -1 on failure
+        * @NOTE: the image must have the same size as the array's layers and is always stored as RGBA
+        */
+        static int LoadTextureLayer(const char* file, std::string name, std::string arrayName);
+
+        //* bindless functions
+
+        /* makes every loaded texture, and every texture loaded afterwards, resident through a bindless handle
+        * @NOTE: returns false when GL_ARB_bindless_texture or OpenGL 4.5 isn't available, the texture units are used instead
+        * @NOTE: handles are stored by texture index within the shader storage buffer at binding 0, used with the quad_bindless shader
+        * @NOTE: texture indices stay the same and are no longer limited by the amount of texture units
+        */
+        static bool EnableBindlessTextures();
+
+        // check if textures are accessed through bindless handles
+        static bool IsBindless();
+
         //* getter functions
 
         // retrieves a stored texture's ID index
@@ -54,6 +80,12 @@ class TextureManager{
         // retrieves a stored font texture
         static CharacterSet& GetFontTexture(std::string name);
 
+        // retrieves a stored texture array
+        static TextureArray& GetTextureArray(std::string name);
+
+        // retrieves the layer of a texture loaded into a texture array
+        static int GetTextureLayer(std::string name);
+
         // retrieves a stored font texture map that contains characters and associated font character
         
         // retrieve a stored sub texture
@@ -71,7 +103,8 @@ class TextureManager{
         //* helper functions
 
         /* binds all textures (except not fonts) from the texture list to be used by OpenGL
-        * @NOTE: is automatically called by LoadTexture()
+        * @NOTE: LoadTexture() only binds the texture it loaded
+        * @NOTE: with OpenGL 4.4+ every texture is bound at once, with bindless textures nothing needs to be bound
         */
         static bool BindTextures();
 
@@ -85,7 +118,15 @@ class TextureManager{
         static std::map<std::string, Texture> Textures;
         static std::map<std::string, CharacterSet> Fonts;
         static std::map<std::string, SubTexture> SubTextures;
+        static std::map<std::string, TextureArray> TextureArrays;
+        static std::map<std::string, int> TextureLayers;
         static std::vector<unsigned int> texIDList;
+        // bindless handles of the textures, in the same order as the texture list
+        static std::vector<GLuint64> texHandleList;
+        // shader storage buffer holding the bindless handles
+        static unsigned int texHandleBuffer;
+        // track if textures are accessed through bindless handles
+        static bool isBindless;
         // track (the caveman way) if the white texture has been generated 
         static bool doesWhiteTexExist;
         
@@ -93,6 +134,12 @@ class TextureManager{
         TextureManager() {}
         // loads a single texture from file
         static Texture loadTextureFromFile(const char *file, bool alpha, bool isLinear);
+        // binds a single texture from the texture list by its index, or adds its bindless handle
+        static bool bindTexture(int index);
+        // makes the bindless handle of a texture from the texture list resident and stores it, without uploading it
+        static void addTextureHandle(int index);
+        // uploads the bindless handles to their shader storage buffer
+        static void uploadTextureHandles();
         // loads a single font from file
         static uint8_t* loadFontFromFile(CharacterSet* chars, const char* file, uint32_t fontAtlasWidth, uint32_t fontAtlasHeight,  float fontSize);
         // properly de-allocates all loaded resources
@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef TEXTURE_ARRAY_HPP
+#define TEXTURE_ARRAY_HPP
+
+//include GLAD
+#include <glad/glad.h>
+
+/* TextureArray is able to store and configure a 2D texture array in OpenGL.
+ Every layer has the same size and format, so a single sampler can read
+ any of them by the layer index. Layers are filled one at a time.
+ *NOTE: By default layers are set to be RGBA format and Nearest filter
+*/
+class TextureArray{
+    private:
+        // holds the ID of the texture array object
+        unsigned int ID;
+
+        // size of every layer in pixels and the amount of layers
+        unsigned int Width, Height, Layers;
+
+        // amount of layers already filled
+        unsigned int Used_Layers;
+
+        // texture Format
+        unsigned int Internal_Format; // format of texture object
+        unsigned int Image_Format; // format of loaded images
+
+        // texture configuration
+        unsigned int Wrap_S; // wrapping mode on S axis
+        unsigned int Wrap_T; // wrapping mode on T axis
+        unsigned int Filter_Min; // filtering mode if texture pixels < screen pixels
+        unsigned int Filter_Max; // filtering mode if texture pixels > screen pixels
+
+    public:
+        // constructor (sets default texture modes)
+        TextureArray();
+
+        //* Helper functions
+
+        // generates an empty texture array with the given layer size and amount of layers
+        void Generate(unsigned int width, unsigned int height, unsigned int layers);
+
+        /* fills the next free layer with image data, returns the layer or -1 when every layer is in use
+        * @NOTE: the data must have the same size and format as the layers
+        */
+        int AddLayer(unsigned char* data);
+
+        // delete the existing texture array
+        void DeleteTexture();
+
+        //* Setter functions
+
+        // set the texture internal format
+        void SetTextureInternalFormat(unsigned int format);
+        // set the texture image format
+        void SetTextureImageFormat(unsigned int format);
+        // set the minimum texture filter
+        void SetTextureFilterMin(unsigned int filter);
+        // set the maximum texture filter
+        void SetTextureFilterMax(unsigned int filter);
+        // set the wrap mode on the S axis
+        void SetWrapS(unsigned int mode);
+        // set the wrap mode on the T axis
+        void SetWrapT(unsigned int mode);
+
+        //* Getter functions
+
+        // retrieves the texture array id
+        unsigned int& GetID();
+        // retrieves the layer width
+        unsigned int GetWidth();
+        // retrieves the layer height
+        unsigned int GetHeight();
+        // retrieves the amount of layers
+        unsigned int GetLayers();
+        // retrieves the amount of filled layers
+        unsigned int GetUsedLayers();
+};
+
+#endif
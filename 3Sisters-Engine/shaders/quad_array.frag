@@ -0,0 +1,13 @@
+#version 450 core
+in vec2 o_TexCoords;
+in vec4 o_quadColor;
+in float o_TexIndex;
+
+out vec4 color;
+
+// every texture is a layer of the same texture array, the texture index is the layer
+uniform sampler2DArray image;
+
+void main(){   
+    color = o_quadColor * texture(image, vec3(o_TexCoords, o_TexIndex));
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 450 core
+#extension GL_ARB_bindless_texture : require
+in vec2 o_TexCoords;
+in vec4 o_quadColor;
+in float o_TexIndex;
+
+out vec4 color;
+
+// bindless handles of every loaded texture, in the order of their texture index
+layout(std430, binding = 0) readonly buffer TextureHandles{
+    uvec2 handles[];
+};
+
+void main(){   
+    color = o_quadColor * texture(sampler2D(handles[int(o_TexIndex + 0.5)]), o_TexCoords);
+}
\ No newline at end of file
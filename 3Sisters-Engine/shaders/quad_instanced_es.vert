@@ -0,0 +1,31 @@
+#version 320 es
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 size;
+layout (location = 2) in float rotation;
+layout (location = 3) in float texIndex;
+layout (location = 4) in vec4 color;
+layout (location = 5) in vec4 texRect;
+
+out vec2 o_TexCoords;
+out float o_TexIndex;
+out vec4 o_quadColor;
+
+uniform mat4 projectionView;
+
+void main(){
+    // corners in the same order as the quad vertices: bottom left, bottom right, top right, top left
+    vec2 corner = vec2((gl_VertexID == 1 || gl_VertexID == 2) ? 0.5 : -0.5, gl_VertexID >= 2 ? 0.5 : -0.5);
+
+    // rotation is given in radians scaled to [-1, 1]
+    float angle = rotation * 3.14159265358979;
+    float s = sin(angle);
+    float c = cos(angle);
+
+    vec2 local = corner * size;
+    vec2 vertex = position + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    gl_Position = projectionView * vec4(vertex, 0.0, 1.0);
+    o_TexCoords = vec2(corner.x < 0.0 ? texRect.x : texRect.z, corner.y < 0.0 ? texRect.y : texRect.w);
+    o_TexIndex = texIndex;
+    o_quadColor = color;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <ecs/command_buffer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+//? include standard library for debug outputs
+#include <iostream>
+
+void* ECS::CommandBuffer::PayloadBlocks::Allocate(std::size_t size, std::size_t alignment){
+    // payloads that can't fit in a block, even when empty, get their own allocation
+    if(size + alignment > COMMAND_BLOCK_SIZE){
+        large.push_back(std::make_unique<std::byte[]>(size + alignment));
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(large.back().get());
+        return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    while(true){
+        if(blockIndex == blocks.size()){
+            blocks.push_back(std::make_unique<std::byte[]>(COMMAND_BLOCK_SIZE));
+        }
+
+        // align the address within the current block
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(blocks[blockIndex].get());
+        std::uintptr_t address = (base + blockOffset + alignment - 1) & ~(alignment - 1);
+
+        if(address + size <= base + COMMAND_BLOCK_SIZE){
+            blockOffset = address + size - base;
+            return reinterpret_cast<void*>(address);
+        }
+
+        // current block is full, move to the next one
+        blockIndex++;
+        blockOffset = 0;
+    }
+}
+
+void ECS::CommandBuffer::PayloadBlocks::Reset(){
+    large.clear();
+    blockIndex = 0;
+    blockOffset = 0;
+}
+
+ECS::CommandBuffer::~CommandBuffer(){
+    discardPayloads(commands);
+}
+
+void ECS::CommandBuffer::discardPayloads(std::vector<Command>& list){
+    for(Command& command : list){
+        if(command.payload != nullptr){
+            command.discard(command.payload);
+            command.payload = nullptr;
+        }
+    }
+}
+
+Entity ECS::CommandBuffer::CreateEntity(){
+    return ECS::ReserveEntity();
+}
+
+void ECS::CommandBuffer::DestroyEntity(Entity entity){
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back({entity, CommandType::Destroy, 0, nullptr, nullptr, nullptr, nullptr});
+}
+
+void ECS::CommandBuffer::Apply(){
+    // entities reserved while recording become alive before their commands are applied
+    ECS::entityManager->FlushReserved();
+
+    // take the recorded commands so that new commands can be recorded while applying
+    std::vector<Command> pending;
+    PayloadBlocks pendingPayloads;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(pending, commands);
+        std::swap(pendingPayloads, payloads);
+    }
+
+    // group the commands of each entity together while keeping their recorded order
+    std::stable_sort(pending.begin(), pending.end(), [](const Command& a, const Command& b){
+        return a.entity < b.entity;
+    });
+
+    std::size_t start = 0;
+    while(start < pending.size()){
+        Entity entity = pending[start].entity;
+
+        // find the end of this entity's commands and check if it gets destroyed
+        std::size_t end = start;
+        bool destroyed = false;
+        while(end < pending.size() && pending[end].entity == entity){
+            destroyed |= pending[end].type == CommandType::Destroy;
+            end++;
+        }
+
+        if(!ECS::entityManager->IsValid(entity)){
+            //? display error
+            std::cout << "ERROR: Failed to apply commands to entity: " << entity << " as it isn't alive!\n";
+        }else if(destroyed){
+            // any other command of the entity would be undone by destroying it
+            ECS::DestroyEntity(entity);
+        }else{
+            Signature oldSignature = ECS::entityManager->GetSignature(entity);
+
+            // find the entity's final signature and which of its existing components get replaced
+            Signature signature = oldSignature;
+            Signature replaced;
+            for(std::size_t i = start; i < end; i++){
+                bool adding = pending[i].type == CommandType::Add;
+                signature.set(pending[i].component, adding);
+                if(adding && oldSignature.test(pending[i].component)){
+                    replaced.set(pending[i].component);
+                }
+            }
+            replaced &= signature;
+
+            // observers see removed components before they are removed
+            ECS::notify(ComponentEvent::Remove, entity, oldSignature & ~signature);
+
+            if(ECS::storageOption == 'a'){
+                // move the entity into its final archetype once, removed components are destroyed by the move
+                ECS::archetypeManager->MoveEntity(entity, signature);
+
+                // only the last add of each component is placed, the earlier ones would be replaced by it
+                Signature placed;
+                for(std::size_t i = end; i-- > start;){
+                    Command& command = pending[i];
+                    if(command.type != CommandType::Add || !signature.test(command.component) || placed.test(command.component)){
+                        continue;
+                    }
+
+                    // components kept from before the move are still constructed
+                    bool constructed = oldSignature.test(command.component);
+                    command.place(ECS::archetypeManager->GetComponent(entity, command.component), command.payload, constructed);
+                    command.payload = nullptr;
+
+                    ECS::archetypeManager->MarkChanged(entity, command.component);
+                    placed.set(command.component);
+                }
+            }else{
+                for(std::size_t i = start; i < end; i++){
+                    Command& command = pending[i];
+
+                    if(command.type == CommandType::Add){
+                        command.store(entity, command.component, command.payload);
+                        command.payload = nullptr;
+                    }else{
+                        ECS::eraseComponent(entity, command.component);
+                    }
+                }
+            }
+
+            // notify the systems once with the entity's final signature
+            if(signature != oldSignature){
+                ECS::entityManager->SetSignature(entity, signature);
+                ECS::systemManager->EntitySignatureChange(entity, oldSignature, signature);
+            }
+
+            ECS::notify(ComponentEvent::Add, entity, signature & ~oldSignature);
+            ECS::notify(ComponentEvent::Change, entity, replaced);
+        }
+
+        start = end;
+    }
+
+    // destroy the payloads that weren't stored and give the blocks back for reuse
+    discardPayloads(pending);
+    pendingPayloads.Reset();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(commands.empty()){
+        std::swap(payloads, pendingPayloads);
+    }
+}
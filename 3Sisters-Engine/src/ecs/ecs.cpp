@@ -7,20 +7,27 @@
 std::unique_ptr<EntityManager> ECS::entityManager;
 std::unique_ptr<ComponentManager> ECS::componentManager;
 std::unique_ptr<SystemManager> ECS::systemManager;
+std::unique_ptr<ArchetypeManager> ECS::archetypeManager;
+std::unique_ptr<ObserverManager> ECS::observerManager;
+std::unique_ptr<ResourceManager> ECS::resourceManager;
+char ECS::storageOption = 's';
 
-void ECS::Init(char debugOption){
+void ECS::Init(char debugOption, char storage, Entity maxEntities){
     // check each ECS manager if they've been initialized
 
     if(entityManager.get() == nullptr){
-        entityManager = std::make_unique<EntityManager>();
+        entityManager = std::make_unique<EntityManager>(maxEntities);
     }else {
         if(debugOption == 'd')
             std::cout << "ERROR: ECS being initialized more than once!\n";
         return;
     }
 
+    // set the storage option before any component is registered
+    storageOption = storage;
+
     if(componentManager.get() == nullptr){
-        componentManager = std::make_unique<ComponentManager>(debugOption);
+        componentManager = std::make_unique<ComponentManager>(debugOption, storageOption);
     }else {
         if(debugOption == 'd')
             std::cout << "ERROR: ECS being initialized more than once!\n";
@@ -34,6 +41,13 @@ void ECS::Init(char debugOption){
             std::cout << "ERROR: ECS being initialized more than once!\n";
         return;
     }
+
+    if(storageOption == 'a'){
+        archetypeManager = std::make_unique<ArchetypeManager>(debugOption);
+    }
+
+    observerManager = std::make_unique<ObserverManager>();
+    resourceManager = std::make_unique<ResourceManager>();
 }
 
 Entity ECS::CreateEntity(){
@@ -41,11 +55,100 @@ Entity ECS::CreateEntity(){
 }
 
 void ECS::DestroyEntity(Entity entity){
+    // reserved entities can be destroyed once they are alive
+    entityManager->FlushReserved();
+
+    //? check if the entity was already destroyed
+    if(!entityManager->IsValid(entity)){
+        std::cout << "ERROR: Failed to destroy entity: " << entity << " as it isn't alive!\n";
+        return;
+    }
+
+    // keep the signature to know which systems contain the entity
+    Signature signature = entityManager->GetSignature(entity);
+
+    // observers see the components before they are removed
+    notify(ComponentEvent::Remove, entity, signature);
+
     entityManager->DestroyEntity(entity);
 
-    componentManager->EntityDestroyed(entity);
+    if(storageOption == 'a'){
+        archetypeManager->EntityDestroyed(entity);
+    }else{
+        componentManager->EntityDestroyed(entity, signature);
+    }
 
-    systemManager->EntityDestroyed(entity);
-    systemManager->EntitySignatureChange(entity, entityManager->GetSignature(entity));
+    systemManager->EntityDestroyed(entity, signature);
 }
 
+
+void ECS::DestroyEntities(std::span<const Entity> entities){
+    std::vector<Entity> destroyed;
+    destroyed.reserve(entities.size());
+
+    // every component any destroyed entity had, used to find the systems to update
+    Signature combinedSignature;
+
+    // reserved entities can be destroyed once they are alive
+    entityManager->FlushReserved();
+
+    for(Entity entity : entities){
+        //? skip entities that were already destroyed, including duplicates within the batch
+        if(!entityManager->IsValid(entity)){
+            std::cout << "ERROR: Failed to destroy entity: " << entity << " as it isn't alive!\n";
+            continue;
+        }
+
+        Signature signature = entityManager->GetSignature(entity);
+        combinedSignature |= signature;
+
+        // observers see the components before they are removed, once per destroyed entity
+        notify(ComponentEvent::Remove, entity, signature);
+
+        entityManager->DestroyEntity(entity);
+
+        if(storageOption == 'a'){
+            archetypeManager->EntityDestroyed(entity);
+        }else{
+            componentManager->EntityDestroyed(entity, signature);
+        }
+
+        destroyed.push_back(entity);
+    }
+
+    systemManager->EntitiesDestroyed(destroyed.data(), destroyed.size(), combinedSignature);
+}
+
+void ECS::eraseComponent(Entity entity, ComponentType type){
+    if(storageOption == 'a'){
+        // check first as the archetype manager reports missing components
+        if(archetypeManager->GetComponent(entity, type) != nullptr){
+            archetypeManager->RemoveComponent(entity, type);
+        }
+    }else{
+        componentManager->RemoveComponent(entity, type);
+    }
+}
+
+void* ECS::getComponentData(Entity entity, ComponentType type){
+    if(storageOption == 'a'){
+        return archetypeManager->GetComponent(entity, type);
+    }
+
+    return componentManager->GetComponentData(entity, type);
+}
+
+void ECS::notify(ComponentEvent event, Entity entity, Signature types){
+    // skip quickly when no given component type is observed
+    types &= observerManager->GetObserved(event);
+    if(types.none()){
+        return;
+    }
+
+    types.ForEach([&](ComponentType type){
+        void* component = getComponentData(entity, type);
+        if(component != nullptr){
+            observerManager->Notify(event, type, entity, component);
+        }
+    });
+}
@@ -0,0 +1,91 @@
+#include <ecs/managers/archetype_manager.hpp>
+
+ArchetypeManager::ArchetypeManager(char option){
+    debugOption = option;
+}
+
+void ArchetypeManager::RegisterComponent(ComponentType type, ComponentInfo info){
+    if(type >= MAX_COMPONENTS){
+        //? display error
+        std::cout << "ERROR: Component type out of range!\n";
+        return;
+    }
+
+    componentInfos[type] = info;
+}
+
+Archetype* ArchetypeManager::getArchetype(Signature signature){
+    auto found = archetypes.find(signature);
+    if(found != archetypes.end()){
+        return found->second.get();
+    }
+
+    // gather the info of each component in the signature, tags are part of the signature but get no column
+    std::vector<std::pair<ComponentType, ComponentInfo>> components;
+    signature.ForEach([&](ComponentType type){
+        if(componentInfos[type].tagInstance == nullptr){
+            components.push_back({type, componentInfos[type]});
+        }
+    });
+
+    // create the archetype and keep track of it
+    auto archetype = std::make_unique<Archetype>(signature, components);
+    Archetype* pointer = archetype.get();
+    archetypes.insert({signature, std::move(archetype)});
+    archetypeList.push_back(pointer);
+
+    return pointer;
+}
+
+Archetype* ArchetypeManager::moveEntity(Entity entity, Signature signature){
+    EntityRecord& record = records[GetEntityIndex(entity)];
+    Archetype* source = record.archetype;
+    Archetype* destination = signature.none() ? nullptr : getArchetype(signature);
+
+    if(source == destination){
+        return destination;
+    }
+
+    if(source == nullptr){
+        // entity had no components, only a new row is needed
+        record.row = destination->PushEntity(entity);
+    }else{
+        std::size_t row = record.row;
+
+        if(destination == nullptr){
+            source->RemoveRow(row);
+        }else{
+            record.row = source->MoveRow(row, *destination);
+        }
+
+        // the last entity of the source archetype was moved into the freed row
+        if(row < source->Size()){
+            records[GetEntityIndex(source->GetEntity(row))].row = row;
+        }
+    }
+
+    record.archetype = destination;
+
+    return destination;
+}
+
+void ArchetypeManager::RemoveComponent(Entity entity, ComponentType type){
+    if(GetComponent(entity, type) == nullptr){
+        if(debugOption == 'd'){
+            std::cout << "ERROR: Entity doesn't have such component to remove!\n";
+        }
+        return;
+    }
+
+    Signature signature = records[GetEntityIndex(entity)].archetype->GetSignature();
+    signature.reset(type);
+
+    moveEntity(entity, signature);
+}
+
+void ArchetypeManager::EntityDestroyed(Entity entity){
+    Entity index = GetEntityIndex(entity);
+    if(records.Contains(index) && records[index].archetype != nullptr && records[index].archetype->GetEntity(records[index].row) == entity){
+        moveEntity(entity, Signature());
+    }
+}
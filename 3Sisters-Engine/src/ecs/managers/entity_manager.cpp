@@ -5,61 +5,341 @@
 //? include standard library for debug prints
 #include <iostream>
 
-EntityManager::EntityManager(){
-    // initialize the queue with all possible entity IDs
-    for(Entity entity = 0; entity < MAX_ENTITIES; entity++){
-        availableEntities.push(entity);
+EntityManager::EntityManager(Entity maximum){
+    // handles are given out on demand, nothing needs to be preallocated
+    maxEntities = maximum < MAX_ENTITIES ? maximum : MAX_ENTITIES;
+}
+
+EntityManager::~EntityManager(){
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    // threads that outlive the manager must not return their handles to it
+    for(ReserveCache* cache : caches){
+        cache->owner = nullptr;
+        cache->count = 0;
+    }
+}
+
+EntityManager::ReserveCache::~ReserveCache(){
+    if(owner == nullptr){
+        return;
     }
+
+    // the handles stay reserved until the next flush gives them back
+    std::lock_guard<std::mutex> lock(owner->cacheMutex);
+    owner->orphaned.insert(owner->orphaned.end(), handles, handles + count);
+    std::erase(owner->caches, this);
+}
+
+std::size_t EntityManager::reserve(Entity* output, std::size_t amount){
+    // claim a share of the remaining entity budget first
+    uint32_t reserved = reservedCount.load(std::memory_order_relaxed);
+    std::size_t claimed;
+    do{
+        std::size_t available = maxEntities - livingEntityCount - reserved;
+        claimed = amount < available ? amount : available;
+        if(claimed == 0){
+            return 0;
+        }
+    }while(!reservedCount.compare_exchange_weak(reserved, reserved + (uint32_t)claimed, std::memory_order_acq_rel));
+
+    // pop a batch of slots off the free list, the slots aren't written until flushed so walking them is safe
+    std::size_t taken = 0;
+    Entity head = reserveHead.load(std::memory_order_acquire);
+    while(head != ENTITY_INDEX_MASK){
+        Entity next = head;
+        taken = 0;
+        while(taken < claimed && next != ENTITY_INDEX_MASK){
+            Entity slot = entities[next];
+            output[taken++] = MakeEntity(next, GetEntityGeneration(slot));
+            next = GetEntityIndex(slot);
+        }
+
+        if(reserveHead.compare_exchange_weak(head, next, std::memory_order_acq_rel)){
+            break;
+        }
+        taken = 0;
+    }
+
+    // the rest are new indices, as long as any are left
+    if(taken < claimed){
+        Entity needed = (Entity)(claimed - taken);
+        Entity index = reserveNext.load(std::memory_order_relaxed);
+        do{
+            if(ENTITY_INDEX_MASK - index < needed){
+                // give back the share of the budget that can't be handed out
+                reservedCount.fetch_sub((uint32_t)needed, std::memory_order_acq_rel);
+                return taken;
+            }
+        }while(!reserveNext.compare_exchange_weak(index, index + needed, std::memory_order_relaxed));
+
+        while(taken < claimed){
+            output[taken++] = MakeEntity(index++, 0);
+        }
+    }
+
+    return claimed;
+}
+
+void EntityManager::release(Entity handle){
+    Entity index = GetEntityIndex(handle);
+    entities[index] = MakeEntity(freeList, GetEntityGeneration(handle));
+    freeList = index;
+}
+
+Entity EntityManager::ReserveEntity(){
+    // each thread keeps its own batch of handles so most reservations don't touch shared state
+    thread_local ReserveCache cache;
+
+    if(cache.owner != this){
+        if(cache.owner != nullptr){
+            // the thread's cache belongs to another manager, reserve a single handle directly
+            Entity handle;
+            if(reserve(&handle, 1) == 0){
+                //? display error
+                std::cout << "ERROR: Too many entities in existance!\n";
+                return NULL_ENTITY;
+            }
+            return handle;
+        }
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        caches.push_back(&cache);
+        cache.owner = this;
+    }
+
+    if(cache.count == 0){
+        cache.count = reserve(cache.handles, ENTITY_RESERVE_BATCH);
+        if(cache.count == 0){
+            //? display error
+            std::cout << "ERROR: Too many entities in existance!\n";
+            return NULL_ENTITY;
+        }
+    }
+
+    return cache.handles[--cache.count];
+}
+
+void EntityManager::FlushReserved(){
+    if(reservedCount.load(std::memory_order_acquire) == 0){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    // every reserved slot of the free list becomes alive with the generation stored in it
+    Entity head = reserveHead.load(std::memory_order_relaxed);
+    while(freeList != head){
+        Entity index = freeList;
+        Entity slot = entities[index];
+        freeList = GetEntityIndex(slot);
+        entities[index] = MakeEntity(index, GetEntityGeneration(slot));
+    }
+
+    // and so does every reserved new index
+    Entity next = reserveNext.load(std::memory_order_relaxed);
+    while(nextEntity < next){
+        Entity index = nextEntity++;
+        entities.Assure(index) = MakeEntity(index, 0);
+    }
+
+    livingEntityCount += reservedCount.load(std::memory_order_relaxed);
+
+    // handles that are still cached were never handed out, give them back
+    for(ReserveCache* cache : caches){
+        for(std::size_t i = 0; i < cache->count; i++){
+            release(cache->handles[i]);
+        }
+        livingEntityCount -= (uint32_t)cache->count;
+        cache->count = 0;
+    }
+
+    for(Entity handle : orphaned){
+        release(handle);
+    }
+    livingEntityCount -= (uint32_t)orphaned.size();
+    orphaned.clear();
+
+    reservedCount.store(0, std::memory_order_relaxed);
+    syncReservations();
 }
 
 Entity EntityManager::CreateEntity(){
-    if(livingEntityCount > MAX_ENTITIES){
+    FlushReserved();
+
+    if(livingEntityCount >= maxEntities){
         //? display error
         std::cout << "ERROR: Too many entities in existance!\n"; 
-        return 0;
+        return NULL_ENTITY;
+    }
+
+    Entity id;
+
+    if(freeList != ENTITY_INDEX_MASK){
+        // take the first free slot, it holds the next free slot and the generation to use
+        Entity index = freeList;
+        Entity slot = entities[index];
+        freeList = GetEntityIndex(slot);
+
+        id = MakeEntity(index, GetEntityGeneration(slot));
+        entities[index] = id;
+    }else{
+        //? check if every index has been handed out, only possible once enough slots are retired
+        if(nextEntity == ENTITY_INDEX_MASK){
+            //? display error
+            std::cout << "ERROR: No entity indices are left!\n";
+            return NULL_ENTITY;
+        }
+
+        // otherwise hand out a new index
+        Entity index = nextEntity++;
+
+        id = MakeEntity(index, 0);
+        entities.Assure(index) = id;
     }
 
-    // take an ID from the front of the queue
-    Entity id = availableEntities.front();
-    availableEntities.pop();
     livingEntityCount++;
+    syncReservations();
 
     return id;
 }
 
+std::size_t EntityManager::CreateEntities(Entity* output, std::size_t amount){
+    FlushReserved();
+
+    if(livingEntityCount + amount > maxEntities){
+        //? display error
+        std::cout << "ERROR: Too many entities in existance!\n"; 
+        amount = maxEntities - livingEntityCount;
+    }
+
+    std::size_t created = 0;
+
+    // reuse destroyed indices first
+    while(created < amount && freeList != ENTITY_INDEX_MASK){
+        Entity index = freeList;
+        Entity slot = entities[index];
+        freeList = GetEntityIndex(slot);
+
+        output[created] = MakeEntity(index, GetEntityGeneration(slot));
+        entities[index] = output[created];
+        created++;
+    }
+
+    // hand out the rest as a block of new indices
+    if(amount - created > ENTITY_INDEX_MASK - nextEntity){
+        //? display error
+        std::cout << "ERROR: No entity indices are left!\n";
+        amount = created + (ENTITY_INDEX_MASK - nextEntity);
+    }
+
+    while(created < amount){
+        Entity index = nextEntity++;
+
+        output[created] = MakeEntity(index, 0);
+        entities.Assure(index) = output[created];
+        created++;
+    }
+
+    livingEntityCount += created;
+    syncReservations();
+
+    return created;
+}
+
 void EntityManager::DestroyEntity(Entity entity){
-    if(entity > MAX_ENTITIES){
+    FlushReserved();
+
+    if(!IsValid(entity)){
         //? display error
-        std::cout << "ERROR: Entity out of range!\n"; 
+        std::cout << "ERROR: Entity is not alive!\n"; 
         return;
     }
 
+    Entity index = GetEntityIndex(entity);
+
     // invalidate the destroyed entity's signature
-    signatures[entity].reset();
+    if(signatures.Contains(index)){
+        signatures[index].reset();
+    }
 
-    // put the destroyed ID at the back of the queue
-    availableEntities.push(entity);
+    if(GetEntityGeneration(entity) == ENTITY_GENERATION_MASK){
+        // the generation would wrap and make old handles valid again, so the slot is retired instead of reused
+        entities[index] = NULL_ENTITY;
+    }else{
+        // push the slot onto the free list, the next handle of this index gets a new generation
+        entities[index] = MakeEntity(freeList, GetEntityGeneration(entity) + 1);
+        freeList = index;
+    }
     livingEntityCount--;
+    syncReservations();
+}
+
+std::vector<Entity> EntityManager::GetLivingEntities(){
+    FlushReserved();
+
+    std::vector<Entity> living;
+    living.reserve(livingEntityCount);
+
+    // a slot belongs to a living entity when it stores a handle to itself
+    for(Entity index = 0; index < nextEntity; index++){
+        if(GetEntityIndex(entities[index]) == index){
+            living.push_back(entities[index]);
+        }
+    }
+
+    return living;
+}
+
+bool EntityManager::Restore(const Entity* slots, Entity slotCount, Entity freeListHead){
+    FlushReserved();
+
+    uint32_t living = 0;
+    for(Entity index = 0; index < slotCount; index++){
+        if(GetEntityIndex(slots[index]) == index){
+            living++;
+        }
+    }
+
+    if(living > maxEntities || slotCount > MAX_ENTITIES){
+        //? display error
+        std::cout << "ERROR: Failed to restore entities as there would be too many entities in existance!\n";
+        return false;
+    }
+
+    entities.Clear();
+    signatures.Clear();
+
+    for(Entity index = 0; index < slotCount; index++){
+        entities.Assure(index) = slots[index];
+    }
+
+    nextEntity = slotCount;
+    freeList = freeListHead;
+    livingEntityCount = living;
+    syncReservations();
+
+    return true;
 }
 
 void EntityManager::SetSignature(Entity entity, Signature signature){
-    if(entity > MAX_ENTITIES){
+    if(!IsValid(entity)){
         //? display error
-        std::cout << "ERROR: Entity out of range!\n"; 
+        std::cout << "ERROR: Entity is not alive!\n"; 
         return;
     }
 
     // put this entity's signature into the array
-    signatures[entity] = signature;
+    signatures.Assure(GetEntityIndex(entity)) = signature;
 }
 
 Signature EntityManager::GetSignature(Entity entity){
-    if(entity > MAX_ENTITIES){
+    if(!IsValid(entity)){
         //? display error
-        std::cout << "ERROR: Entity out of range!\n"; 
-        return std::bitset<MAX_COMPONENTS>();
+        std::cout << "ERROR: Entity is not alive!\n"; 
+        return Signature();
     }
 
     // get this entity's signature from the array
-    return signatures[entity];
-}
\ No newline at end of file
+    return signatures.Get(GetEntityIndex(entity));
+}
@@ -0,0 +1,90 @@
+#include <ecs/managers/system_manager.hpp>
+
+void SystemManager::SetScheduler(char option, std::size_t threads){
+    schedulerOption = option;
+
+    // recreate the workers on the next parallel update if the amount changed
+    if(threadCount != threads){
+        threadCount = threads;
+        threadPool.reset();
+    }
+}
+
+void SystemManager::rebuildSchedule(){
+    std::size_t count = systems.size();
+
+    dependents.assign(count, {});
+    dependencyCounts.assign(count, 0);
+    remainingDependencies = std::make_unique<std::atomic<std::size_t>[]>(count);
+
+    // a system waits on every earlier system it conflicts with, keeping the order of registration
+    for(std::size_t later = 0; later < count; later++){
+        for(std::size_t earlier = 0; earlier < later; earlier++){
+            const SystemAccess& a = accesses[earlier];
+            const SystemAccess& b = accesses[later];
+
+            // conflicts when either writes a component the other accesses
+            bool conflicts = !a.declared || !b.declared
+                || (a.writes & (b.reads | b.writes)).any()
+                || (b.writes & a.reads).any();
+
+            if(conflicts){
+                dependents[earlier].push_back(later);
+                dependencyCounts[later]++;
+            }
+        }
+    }
+
+    scheduleDirty = false;
+}
+
+void SystemManager::runSystem(std::size_t slot, double deltaTime){
+    systems[slot]->Update(deltaTime);
+
+    // release the systems that waited on this one
+    for(std::size_t dependent : dependents[slot]){
+        if(--remainingDependencies[dependent] == 0){
+            threadPool->Submit([this, dependent, deltaTime](){
+                runSystem(dependent, deltaTime);
+            });
+        }
+    }
+
+    finishedSystems++;
+}
+
+void SystemManager::UpdateSystems(double deltaTime){
+    if(schedulerOption == 's' || systems.size() < 2){
+        for(auto& system : systems){
+            system->Update(deltaTime);
+        }
+        return;
+    }
+
+    if(scheduleDirty){
+        rebuildSchedule();
+    }
+
+    if(threadPool == nullptr){
+        threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+
+    for(std::size_t slot = 0; slot < systems.size(); slot++){
+        remainingDependencies[slot] = dependencyCounts[slot];
+    }
+    finishedSystems = 0;
+
+    // start every system that doesn't wait on another
+    for(std::size_t slot = 0; slot < systems.size(); slot++){
+        if(dependencyCounts[slot] == 0){
+            threadPool->Submit([this, slot, deltaTime](){
+                runSystem(slot, deltaTime);
+            });
+        }
+    }
+
+    // help run systems until all of them have finished
+    threadPool->WaitUntil([this](){
+        return finishedSystems == systems.size();
+    });
+}
@@ -0,0 +1,177 @@
+#include <ecs/prebuilt_systems/transform_system.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+void TransformSystem::Init(){
+    ECS::SetSystemSignature<TransformSystem>(ECS::GetComponentType<Transform2D>(), ECS::GetComponentType<WorldTransform2D>());
+    ECS::SetSystemAccess<TransformSystem>(
+        ECS::GetMultiComponentSignature(ECS::GetComponentType<Transform2D>(), ECS::GetComponentType<Parent>()),
+        ECS::GetComponentSignature<WorldTransform2D>());
+
+    // removed parents leave no change tick behind, so they have to be observed
+    ECS::OnRemove<Parent>([this](Entity entity, Parent&){
+        if(order.Contains(entity)){
+            hierarchyChanged = true;
+        }
+    });
+
+    // entities join once they have both transforms, the system's entities are updated before observers are called
+    ECS::OnAdd<Transform2D>([this](Entity entity, Transform2D&){
+        if(entities.Contains(entity)){
+            hierarchyChanged = true;
+        }
+    });
+    ECS::OnAdd<WorldTransform2D>([this](Entity entity, WorldTransform2D&){
+        if(entities.Contains(entity)){
+            hierarchyChanged = true;
+        }
+    });
+
+    // and leave when either is removed, including when they are destroyed
+    ECS::OnRemove<Transform2D>([this](Entity entity, Transform2D&){
+        if(entities.Contains(entity)){
+            hierarchyChanged = true;
+        }
+    });
+    ECS::OnRemove<WorldTransform2D>([this](Entity entity, WorldTransform2D&){
+        if(entities.Contains(entity)){
+            hierarchyChanged = true;
+        }
+    });
+}
+
+void TransformSystem::rebuild(){
+    std::vector<Entity> members(entities.begin(), entities.end());
+    std::uint32_t count = (std::uint32_t)members.size();
+
+    // find the depth of each entity, parents outside of the system make the entity a root
+    std::vector<std::uint32_t> depths(count);
+    for(std::uint32_t i = 0; i < count; i++){
+        std::uint32_t depth = 0;
+        Entity current = members[i];
+
+        // the depth is capped to the amount of entities in case of cycles
+        while(depth < count && ECS::CheckComponent<Parent>(current)){
+            Entity parent = ECS::GetComponent<Parent>(current).entity;
+            if(!entities.Contains(parent)){
+                break;
+            }
+
+            current = parent;
+            depth++;
+        }
+
+        depths[i] = depth;
+    }
+
+    // sort by depth so every parent comes before its children
+    std::vector<std::uint32_t> sorted(count);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&depths](std::uint32_t a, std::uint32_t b){
+        return depths[a] < depths[b];
+    });
+
+    order.Clear();
+    order.Reserve(count);
+    for(std::uint32_t index : sorted){
+        order.Insert(members[index]);
+    }
+
+    parents.assign(count, noParent);
+    worlds.resize(count);
+    dirty.assign(count, 1);
+
+    for(std::uint32_t i = 0; i < count; i++){
+        Entity entity = order[i];
+        if(!ECS::CheckComponent<Parent>(entity)){
+            continue;
+        }
+
+        // parents that would come after their child are part of a cycle, the child is treated as a root
+        std::size_t parent = order.Find(ECS::GetComponent<Parent>(entity).entity);
+        if(parent < i){
+            parents[i] = (std::uint32_t)parent;
+        }
+    }
+
+    hierarchyChanged = false;
+}
+
+void TransformSystem::compute(std::uint32_t index, const Transform2D& local){
+    WorldTransform2D& world = worlds[index];
+
+    if(parents[index] == noParent){
+        world.position = local.position;
+        world.rotation = local.rotation;
+    }else{
+        // place the entity relative to its parent's position and rotation
+        const WorldTransform2D& parent = worlds[parents[index]];
+        float angle = glm::radians(parent.rotation);
+        float cosine = std::cos(angle);
+        float sine = std::sin(angle);
+
+        world.position = parent.position + glm::vec2(cosine * local.position.x - sine * local.position.y, sine * local.position.x + cosine * local.position.y);
+        world.rotation = parent.rotation + local.rotation;
+    }
+
+    world.size = local.size;
+
+    // same as translate * rotate * scale, without the generic matrix multiplications
+    float angle = glm::radians(world.rotation);
+    float cosine = std::cos(angle);
+    float sine = std::sin(angle);
+
+    world.matrix = glm::mat4(
+        glm::vec4(cosine * world.size.x, sine * world.size.x, 0.0f, 0.0f),
+        glm::vec4(-sine * world.size.y, cosine * world.size.y, 0.0f, 0.0f),
+        glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+        glm::vec4(world.position, 0.0f, 1.0f));
+}
+
+void TransformSystem::Update([[maybe_unused]] double deltaTime){
+    /* advance the tick so changes made after this point are stamped with the new tick,
+     they are picked up by the next update while the ones seen now aren't seen twice
+    */
+    std::uint32_t tick = ECS::AdvanceChangeTick();
+
+    // check if any parent changed
+    if(!hierarchyChanged){
+        ECS::ForEachChanged<Parent>(lastTick, [this](Entity entity, Parent&){
+            if(order.Contains(entity)){
+                hierarchyChanged = true;
+            }
+        });
+    }
+
+    if(hierarchyChanged){
+        rebuild();
+    }else{
+        // only the entities whose transform changed are dirty
+        ECS::ForEachChanged<Transform2D>(lastTick, [this](Entity entity, Transform2D&){
+            std::size_t index = order.Find(entity);
+            if(index != static_cast<std::size_t>(-1)){
+                dirty[index] = 1;
+            }
+        });
+    }
+
+    // parents come first, so a dirty parent is known before its children are visited
+    for(std::uint32_t i = 0; i < order.Size(); i++){
+        if(!dirty[i] && (parents[i] == noParent || !dirty[parents[i]])){
+            continue;
+        }
+
+        dirty[i] = 1;
+
+        Entity entity = order[i];
+        compute(i, ECS::GetComponent<Transform2D>(entity));
+
+        ECS::GetComponent<WorldTransform2D>(entity) = worlds[i];
+        ECS::MarkChanged<WorldTransform2D>(entity);
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+    lastTick = tick;
+}
@@ -0,0 +1,496 @@
+#include <ecs/ecs.hpp>
+
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <unordered_map>
+
+//? include standard library for debug outputs
+#include <iostream>
+
+// identifies the start of a snapshot
+static const char snapshotMagic[4] = {'3', 'S', 'E', 'S'};
+
+// version of the snapshot layout, increase whenever the layout changes
+static const std::uint32_t snapshotVersion = 1;
+
+// every blob within a snapshot starts at a multiple of this, relative to the start of the snapshot
+static const std::size_t snapshotAlignment = 64;
+
+// first bytes of a snapshot
+struct SnapshotHeader{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entitySize;
+    std::uint32_t poolCount;
+    std::uint64_t slotCount;
+    std::uint64_t freeList;
+};
+
+// written before the blobs of each component pool
+struct PoolHeader{
+    std::uint32_t nameLength;
+    std::uint32_t size;
+    std::uint32_t alignment;
+    std::uint32_t reserved;
+    std::uint64_t count;
+};
+
+// a component pool read from a snapshot that matches a registered component
+struct LoadedPool{
+    ComponentType type;
+    std::size_t count;
+    const Entity* entities;
+    const std::byte* components;
+};
+
+// frees memory allocated with the snapshot alignment
+struct AlignedDeleter{
+    void operator()(std::byte* data){
+        ::operator delete(data, std::align_val_t(snapshotAlignment));
+    }
+};
+
+// round a value up to the snapshot alignment
+static std::size_t alignUp(std::size_t value){
+    return (value + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment;
+}
+
+// append raw bytes to the end of a snapshot
+static void write(std::vector<std::byte>& output, const void* data, std::size_t size){
+    std::size_t offset = output.size();
+    output.resize(offset + size);
+    if(size > 0){
+        std::memcpy(output.data() + offset, data, size);
+    }
+}
+
+// pad a snapshot with zeros up to the snapshot alignment
+static void pad(std::vector<std::byte>& output){
+    output.resize(alignUp(output.size()), std::byte{0});
+}
+
+/* Snapshot Reader reads bytes from a snapshot
+and remembers if it tried to read past the end
+*/
+struct SnapshotReader{
+    const std::byte* data;
+    std::size_t size;
+    std::size_t offset = 0;
+    bool failed = false;
+
+    // get the next given amount of bytes, returns nullptr when reading past the end
+    const std::byte* Read(std::size_t bytes){
+        if(failed || bytes > size - offset){
+            failed = true;
+            return nullptr;
+        }
+
+        const std::byte* pointer = data + offset;
+        offset += bytes;
+        return pointer;
+    }
+
+    // get the next count elements of the given size, the amount is checked before multiplying so it can't overflow
+    const std::byte* ReadArray(std::uint64_t count, std::size_t elementSize){
+        if(failed || (elementSize != 0 && count > (size - offset) / elementSize)){
+            failed = true;
+            return nullptr;
+        }
+
+        return Read((std::size_t)count * elementSize);
+    }
+
+    // skip the padding up to the snapshot alignment
+    void Align(){
+        std::size_t aligned = alignUp(offset);
+        if(aligned > size){
+            failed = true;
+            return;
+        }
+        offset = aligned;
+    }
+};
+
+bool ECS::SaveSnapshot(std::vector<std::byte>& output){
+    output.clear();
+
+    // reserved entities are saved as living entities
+    entityManager->FlushReserved();
+
+    // find the component types that can be written as raw memory
+    std::vector<ComponentType> pools;
+    for(ComponentType type = 0; type < componentManager->GetComponentTypeCount(); type++){
+        if(!componentManager->GetComponentDescription(type).triviallyCopyable){
+            std::cout << "WARNING: Component: " << componentManager->GetComponentDescription(type).name << " isn't trivially copyable and won't be saved!\n";
+            continue;
+        }
+        pools.push_back(type);
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.version = snapshotVersion;
+    header.entitySize = sizeof(Entity);
+    header.poolCount = (std::uint32_t)pools.size();
+    header.slotCount = entityManager->GetSlotCount();
+    header.freeList = entityManager->GetFreeList();
+    write(output, &header, sizeof(header));
+
+    // every entity slot, living or destroyed, so handles and generations survive loading
+    pad(output);
+    std::size_t slotOffset = output.size();
+    output.resize(slotOffset + header.slotCount * sizeof(Entity));
+    Entity* slots = reinterpret_cast<Entity*>(output.data() + slotOffset);
+    for(Entity index = 0; index < (Entity)header.slotCount; index++){
+        slots[index] = entityManager->GetSlot(index);
+    }
+
+    for(ComponentType type : pools){
+        const ComponentDescription& description = componentManager->GetComponentDescription(type);
+
+        PoolHeader pool{};
+        pool.nameLength = (std::uint32_t)std::strlen(description.name);
+        pool.size = (std::uint32_t)description.size;
+        pool.alignment = (std::uint32_t)description.alignment;
+
+        if(storageOption == 'a'){
+            Signature query;
+            query.set(type);
+            std::vector<Archetype*> archetypes = archetypeManager->GetArchetypes(query);
+
+            for(Archetype* archetype : archetypes){
+                pool.count += archetype->Size();
+            }
+
+            write(output, &pool, sizeof(pool));
+            write(output, description.name, pool.nameLength);
+
+            // gather the entities and then the components of every chunk into two blobs
+            pad(output);
+            for(Archetype* archetype : archetypes){
+                for(std::size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++){
+                    write(output, archetype->GetChunkEntities(chunk), archetype->GetChunkSize(chunk) * sizeof(Entity));
+                }
+            }
+
+            pad(output);
+            for(Archetype* archetype : archetypes){
+                for(std::size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++){
+                    write(output, archetype->GetChunkColumn(type, chunk), archetype->GetChunkSize(chunk) * description.size);
+                }
+            }
+        }else{
+            IComponentArray* array = componentManager->GetComponentArray(type);
+            pool.count = array->Size();
+
+            write(output, &pool, sizeof(pool));
+            write(output, description.name, pool.nameLength);
+
+            // the packed arrays are already contiguous
+            pad(output);
+            write(output, array->GetEntities(), pool.count * sizeof(Entity));
+            pad(output);
+            write(output, array->GetRawComponents(), pool.count * description.size);
+        }
+    }
+
+    return true;
+}
+
+bool ECS::LoadSnapshot(const std::byte* data, std::size_t size){
+    SnapshotReader reader{data, size};
+
+    SnapshotHeader header{};
+    const std::byte* headerData = reader.Read(sizeof(header));
+    if(headerData == nullptr){
+        std::cout << "ERROR: Failed to load snapshot as it is too small!\n";
+        return false;
+    }
+    std::memcpy(&header, headerData, sizeof(header));
+
+    //? check if the snapshot was written by a compatible build
+    if(std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0 || header.version != snapshotVersion){
+        std::cout << "ERROR: Failed to load snapshot as it isn't a snapshot of version: " << snapshotVersion << "\n";
+        return false;
+    }
+
+    if(header.entitySize != sizeof(Entity)){
+        std::cout << "ERROR: Failed to load snapshot as it was saved with a different entity size!\n";
+        return false;
+    }
+
+    //? check if the slots fit within this build
+    if(header.slotCount > MAX_ENTITIES){
+        std::cout << "ERROR: Failed to load snapshot as it has more entity slots than: " << MAX_ENTITIES << "\n";
+        return false;
+    }
+
+    reader.Align();
+    const Entity* slots = reinterpret_cast<const Entity*>(reader.ReadArray(header.slotCount, sizeof(Entity)));
+
+    // blobs are used in place, the snapshot has to be copied if they aren't aligned in memory
+    bool misaligned = reinterpret_cast<std::uintptr_t>(slots) % alignof(Entity) != 0;
+
+    // read and check every pool before the world is touched
+    std::vector<LoadedPool> pools;
+    for(std::uint32_t i = 0; i < header.poolCount && !reader.failed; i++){
+        PoolHeader pool{};
+        const std::byte* poolData = reader.Read(sizeof(pool));
+        if(poolData == nullptr){
+            break;
+        }
+        std::memcpy(&pool, poolData, sizeof(pool));
+
+        //? check if the alignment is one the blobs can have
+        if(pool.alignment == 0 || (pool.alignment & (pool.alignment - 1)) != 0 || pool.alignment > snapshotAlignment){
+            std::cout << "ERROR: Failed to load snapshot as it is corrupt!\n";
+            return false;
+        }
+
+        const char* name = reinterpret_cast<const char*>(reader.Read(pool.nameLength));
+        reader.Align();
+        const Entity* entities = reinterpret_cast<const Entity*>(reader.ReadArray(pool.count, sizeof(Entity)));
+        reader.Align();
+        const std::byte* components = reader.ReadArray(pool.count, pool.size);
+
+        if(reader.failed){
+            break;
+        }
+
+        // find the registered component with the same name and size
+        std::string poolName(name, pool.nameLength);
+        ComponentType type = UNREGISTERED_COMPONENT;
+        for(ComponentType registered = 0; registered < componentManager->GetComponentTypeCount(); registered++){
+            const ComponentDescription& description = componentManager->GetComponentDescription(registered);
+            if(poolName == description.name && description.size == pool.size && description.triviallyCopyable){
+                type = registered;
+                break;
+            }
+        }
+
+        if(type == UNREGISTERED_COMPONENT){
+            std::cout << "WARNING: Snapshot component: " << poolName << " isn't registered or changed its layout and won't be loaded!\n";
+            continue;
+        }
+
+        misaligned |= reinterpret_cast<std::uintptr_t>(entities) % alignof(Entity) != 0;
+        misaligned |= reinterpret_cast<std::uintptr_t>(components) % pool.alignment != 0;
+
+        pools.push_back({type, (std::size_t)pool.count, entities, components});
+    }
+
+    if(reader.failed){
+        std::cout << "ERROR: Failed to load snapshot as it is cut short!\n";
+        return false;
+    }
+
+    // copy the snapshot into aligned memory once and use the blobs from there
+    std::unique_ptr<std::byte, AlignedDeleter> aligned;
+    if(misaligned){
+        aligned.reset(static_cast<std::byte*>(::operator new(size, std::align_val_t(snapshotAlignment))));
+        std::memcpy(aligned.get(), data, size);
+
+        // every blob starts at a multiple of the snapshot alignment, so keeping its offset keeps it aligned
+        auto rebase = [&](const auto* pointer){
+            return reinterpret_cast<decltype(pointer)>(aligned.get() + (reinterpret_cast<const std::byte*>(pointer) - data));
+        };
+        slots = rebase(slots);
+        for(LoadedPool& pool : pools){
+            pool.entities = rebase(pool.entities);
+            pool.components = rebase(pool.components);
+        }
+    }
+
+    //? check if the free list only goes through destroyed slots and ends
+    Entity living = 0;
+    for(Entity index = 0; index < (Entity)header.slotCount; index++){
+        if(GetEntityIndex(slots[index]) == index){
+            living++;
+        }
+    }
+
+    // every destroyed slot is on the free list at most once, a longer walk means it loops
+    bool corrupt = header.freeList != ENTITY_INDEX_MASK && header.freeList >= header.slotCount;
+    Entity free = corrupt ? ENTITY_INDEX_MASK : (Entity)header.freeList;
+    for(Entity steps = 0; free != ENTITY_INDEX_MASK && !corrupt; steps++){
+        corrupt = free >= header.slotCount || GetEntityIndex(slots[free]) == free || steps >= (Entity)header.slotCount - living;
+        free = corrupt ? ENTITY_INDEX_MASK : GetEntityIndex(slots[free]);
+    }
+
+    if(corrupt){
+        std::cout << "ERROR: Failed to load snapshot as its free list is corrupt!\n";
+        return false;
+    }
+
+    if(living > entityManager->GetMaxEntities()){
+        std::cout << "ERROR: Failed to load snapshot as it has more living entities than: " << entityManager->GetMaxEntities() << "\n";
+        return false;
+    }
+
+    //? check if every entity of each pool is alive within the snapshot and listed once, and every component has a single pool
+    Signature loadedTypes;
+    std::vector<std::uint32_t> listedBy(header.slotCount, static_cast<std::uint32_t>(-1));
+    for(std::uint32_t p = 0; p < pools.size(); p++){
+        const LoadedPool& pool = pools[p];
+        const char* name = componentManager->GetComponentDescription(pool.type).name;
+
+        if(loadedTypes.test(pool.type)){
+            std::cout << "ERROR: Failed to load snapshot as component: " << name << " has more than one pool!\n";
+            return false;
+        }
+        loadedTypes.set(pool.type);
+
+        for(std::size_t i = 0; i < pool.count; i++){
+            Entity index = GetEntityIndex(pool.entities[i]);
+            if(index >= header.slotCount || slots[index] != pool.entities[i]){
+                std::cout << "ERROR: Failed to load snapshot as component: " << name << " belongs to an entity that isn't alive!\n";
+                return false;
+            }
+
+            if(listedBy[index] == p){
+                std::cout << "ERROR: Failed to load snapshot as component: " << name << " lists an entity more than once!\n";
+                return false;
+            }
+            listedBy[index] = p;
+        }
+    }
+
+    // the snapshot is known to load, clear the world and then restore every entity handle
+    DestroyEntities(entityManager->GetLivingEntities());
+    if(!entityManager->Restore(slots, (Entity)header.slotCount, (Entity)header.freeList)){
+        return false;
+    }
+
+    // rebuild each entity's signature from the pools it is part of
+    for(const LoadedPool& pool : pools){
+        for(std::size_t i = 0; i < pool.count; i++){
+            Signature signature = entityManager->GetSignature(pool.entities[i]);
+            signature.set(pool.type);
+            entityManager->SetSignature(pool.entities[i], signature);
+        }
+    }
+
+    // group the entities by signature so storage and systems are filled once per group,
+    // entities keep the order of the first pool listing them so their components can be copied in runs
+    std::unordered_map<Signature, std::vector<Entity>> groups;
+    std::vector<std::uint8_t> grouped(header.slotCount, 0);
+    for(const LoadedPool& pool : pools){
+        for(std::size_t i = 0; i < pool.count; i++){
+            Entity index = GetEntityIndex(pool.entities[i]);
+            if(!grouped[index]){
+                grouped[index] = 1;
+                groups[entityManager->GetSignature(pool.entities[i])].push_back(pool.entities[i]);
+            }
+        }
+    }
+
+    if(storageOption == 'a'){
+        std::uint32_t tick = ChangeTick::Get();
+
+        // a group's rows within its archetype
+        struct PushedGroup{
+            Signature signature;
+            const std::vector<Entity>* entities;
+            Archetype* archetype;
+            std::size_t first;
+        };
+
+        // add every group to its archetype and stamp the new rows
+        std::vector<PushedGroup> pushed;
+        pushed.reserve(groups.size());
+        for(auto& [signature, entities] : groups){
+            auto [archetype, first] = archetypeManager->PushEntities(entities.data(), entities.size(), signature);
+            signature.ForEach([&](ComponentType type){
+                archetype->MarkChanged(type, first, tick, entities.size());
+            });
+            pushed.push_back({signature, &entities, archetype, first});
+        }
+
+        // copy each pool group by group, entities next to each other in both the pool and a chunk are copied at once
+        std::vector<std::uint32_t> position(header.slotCount);
+        for(const LoadedPool& pool : pools){
+            // tags have nothing to copy
+            std::size_t componentSize = componentManager->GetComponentDescription(pool.type).size;
+            if(componentSize == 0){
+                continue;
+            }
+
+            for(std::size_t i = 0; i < pool.count; i++){
+                position[GetEntityIndex(pool.entities[i])] = (std::uint32_t)i;
+            }
+
+            for(const PushedGroup& group : pushed){
+                if(!group.signature.test(pool.type)){
+                    continue;
+                }
+
+                const std::vector<Entity>& entities = *group.entities;
+                std::size_t capacity = group.archetype->GetChunkCapacity();
+                std::size_t start = 0;
+                while(start < entities.size()){
+                    std::size_t row = group.first + start;
+                    std::size_t source = position[GetEntityIndex(entities[start])];
+
+                    // extend the run while the next entity follows within the pool and the chunk
+                    std::size_t end = start + 1;
+                    std::size_t chunkEnd = start + (capacity - row % capacity);
+                    while(end < entities.size() && end < chunkEnd && position[GetEntityIndex(entities[end])] == source + (end - start)){
+                        end++;
+                    }
+
+                    std::byte* column = static_cast<std::byte*>(group.archetype->GetChunkColumn(pool.type, row / capacity));
+                    std::memcpy(column + (row % capacity) * componentSize, pool.components + source * componentSize, (end - start) * componentSize);
+                    start = end;
+                }
+            }
+        }
+    }else{
+        // each pool is copied in one go
+        for(const LoadedPool& pool : pools){
+            componentManager->GetComponentArray(pool.type)->InsertRaw(pool.entities, pool.count, pool.components);
+        }
+    }
+
+    for(auto& [signature, entities] : groups){
+        systemManager->EntitiesSignatureChange(entities.data(), entities.size(), Signature(), signature);
+    }
+
+    return true;
+}
+
+bool ECS::SaveWorld(const char* path){
+    std::vector<std::byte> snapshot;
+    if(!SaveSnapshot(snapshot)){
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file){
+        std::cout << "ERROR: Failed to open file: " << path << " to save the world!\n";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+    return (bool)file;
+}
+
+bool ECS::LoadWorld(const char* path){
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file){
+        std::cout << "ERROR: Failed to open file: " << path << " to load the world!\n";
+        return false;
+    }
+
+    // read the whole file at once into aligned memory so the blobs can be used in place
+    std::size_t size = (std::size_t)file.tellg();
+    file.seekg(0);
+
+    std::unique_ptr<std::byte, AlignedDeleter> buffer(static_cast<std::byte*>(::operator new(size > 0 ? size : 1, std::align_val_t(snapshotAlignment))));
+    if(!file.read(reinterpret_cast<char*>(buffer.get()), size)){
+        std::cout << "ERROR: Failed to read file: " << path << " to load the world!\n";
+        return false;
+    }
+
+    return LoadSnapshot(buffer.get(), size);
+}
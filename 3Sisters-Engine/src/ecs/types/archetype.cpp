@@ -0,0 +1,191 @@
+#include <ecs/types/archetype.hpp>
+
+#include <algorithm>
+
+// minimum alignment of every allocated chunk, matches a cache line
+static const std::size_t cacheLineAlignment = 64;
+
+// round a value up to the next multiple of a given alignment
+static std::size_t alignUp(std::size_t value, std::size_t alignment){
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+Archetype::Archetype(Signature sig, const std::vector<std::pair<ComponentType, ComponentInfo>>& components){
+    signature = sig;
+    columnIndices.fill(-1);
+
+    // calculate the size of a row and the worst case padding between columns
+    std::size_t rowBytes = sizeof(Entity);
+    std::size_t padding = 0;
+    chunkAlignment = cacheLineAlignment;
+    for(auto const& pair : components){
+        columnIndices[pair.first] = (int)columnTypes.size();
+        columnTypes.push_back(pair.first);
+        columnInfos.push_back(pair.second);
+
+        rowBytes += pair.second.size + sizeof(std::uint32_t);
+        padding += pair.second.alignment - 1 + alignof(std::uint32_t) - 1;
+
+        // columns are laid out from the start of a chunk, so the chunk has to be aligned for every component
+        chunkAlignment = std::max(chunkAlignment, pair.second.alignment);
+    }
+
+    // fit as many rows as possible into a chunk, large components get at least one row
+    chunkCapacity = ARCHETYPE_CHUNK_SIZE > padding ? (ARCHETYPE_CHUNK_SIZE - padding) / rowBytes : 0;
+    if(chunkCapacity == 0){
+        chunkCapacity = 1;
+    }
+
+    // lay out each column and its change ticks after the entity column
+    std::size_t offset = chunkCapacity * sizeof(Entity);
+    for(auto const& info : columnInfos){
+        offset = alignUp(offset, info.alignment);
+        columnOffsets.push_back(offset);
+        offset += chunkCapacity * info.size;
+
+        offset = alignUp(offset, alignof(std::uint32_t));
+        tickOffsets.push_back(offset);
+        offset += chunkCapacity * sizeof(std::uint32_t);
+    }
+
+    chunkBytes = alignUp(offset > ARCHETYPE_CHUNK_SIZE ? offset : ARCHETYPE_CHUNK_SIZE, chunkAlignment);
+}
+
+Archetype::~Archetype(){
+    // destroy every remaining component
+    for(std::size_t row = 0; row < count; row++){
+        for(std::size_t column = 0; column < columnInfos.size(); column++){
+            columnInfos[column].destroy(getAddress(column, row));
+        }
+    }
+
+    // free the chunks
+    for(std::byte* chunk : chunks){
+        ::operator delete(chunk, std::align_val_t(chunkAlignment));
+    }
+}
+
+void Archetype::allocateChunk(){
+    chunks.push_back(static_cast<std::byte*>(::operator new(chunkBytes, std::align_val_t(chunkAlignment))));
+    chunkTicks.resize(chunks.size() * columnTypes.size(), 0);
+}
+
+void Archetype::releaseChunks(){
+    // keep the chunks in use and a single spare, so an entity moving back and forth doesn't reallocate every time
+    std::size_t used = (count + chunkCapacity - 1) / chunkCapacity;
+    while(chunks.size() > used + 1){
+        ::operator delete(chunks.back(), std::align_val_t(chunkAlignment));
+        chunks.pop_back();
+    }
+    chunkTicks.resize(chunks.size() * columnTypes.size());
+}
+
+void Archetype::setTicks(std::size_t column, std::size_t row, std::size_t amount, std::uint32_t tick){
+    std::fill_n(getTickAddress(column, row), amount, tick);
+
+    // keep the newest tick of the chunk
+    std::uint32_t& chunkTick = chunkTicks[(row / chunkCapacity) * columnTypes.size() + column];
+    if(ChangeTick::IsNewer(tick, chunkTick)){
+        chunkTick = tick;
+    }
+}
+
+void Archetype::MarkChanged(ComponentType type, std::size_t row, std::uint32_t tick, std::size_t amount){
+    int column = columnIndices[type];
+    if(column == -1){
+        return;
+    }
+
+    // stamp the rows one chunk at a time
+    std::size_t marked = 0;
+    while(marked < amount){
+        std::size_t current = row + marked;
+        std::size_t space = chunkCapacity - (current % chunkCapacity);
+        std::size_t batch = (amount - marked) < space ? (amount - marked) : space;
+
+        setTicks(column, current, batch, tick);
+        marked += batch;
+    }
+}
+
+std::size_t Archetype::PushEntity(Entity entity){
+    // allocate another chunk when all chunks are full
+    if(count == chunks.size() * chunkCapacity){
+        allocateChunk();
+    }
+
+    std::size_t row = count;
+    *getEntityAddress(row) = entity;
+    count++;
+
+    return row;
+}
+
+std::size_t Archetype::PushEntities(const Entity* entities, std::size_t amount){
+    // allocate every chunk needed up front
+    while(count + amount > chunks.size() * chunkCapacity){
+        allocateChunk();
+    }
+
+    std::size_t first = count;
+
+    // copy the entities into each chunk's entity column
+    std::size_t copied = 0;
+    while(copied < amount){
+        std::size_t row = first + copied;
+        std::size_t space = chunkCapacity - (row % chunkCapacity);
+        std::size_t batch = (amount - copied) < space ? (amount - copied) : space;
+
+        std::copy_n(entities + copied, batch, getEntityAddress(row));
+        copied += batch;
+    }
+
+    count += amount;
+
+    return first;
+}
+
+void Archetype::RemoveRow(std::size_t row){
+    std::size_t lastRow = count - 1;
+
+    // destroy the components of the removed row
+    for(std::size_t column = 0; column < columnInfos.size(); column++){
+        columnInfos[column].destroy(getAddress(column, row));
+    }
+
+    // move the last row into the removed row's place to maintain density
+    if(row != lastRow){
+        for(std::size_t column = 0; column < columnInfos.size(); column++){
+            void* last = getAddress(column, lastRow);
+            columnInfos[column].moveConstruct(getAddress(column, row), last);
+            columnInfos[column].destroy(last);
+            setTicks(column, row, 1, *getTickAddress(column, lastRow));
+        }
+        *getEntityAddress(row) = *getEntityAddress(lastRow);
+    }
+
+    count--;
+
+    // free the trailing chunks once the last one in use empties
+    if(count % chunkCapacity == 0){
+        releaseChunks();
+    }
+}
+
+std::size_t Archetype::MoveRow(std::size_t row, Archetype& destination){
+    std::size_t newRow = destination.PushEntity(GetEntity(row));
+
+    // move every component that both archetypes share
+    for(std::size_t column = 0; column < columnInfos.size(); column++){
+        void* target = destination.GetComponent(columnTypes[column], newRow);
+        if(target != nullptr){
+            columnInfos[column].moveConstruct(target, getAddress(column, row));
+            destination.MarkChanged(columnTypes[column], newRow, *getTickAddress(column, row));
+        }
+    }
+
+    // destroy what's left of the row, moved from components included
+    RemoveRow(row);
+
+    return newRow;
+}
@@ -0,0 +1,101 @@
+#include <ecs/types/thread_pool.hpp>
+
+thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local std::size_t ThreadPool::currentQueue = 0;
+
+ThreadPool::ThreadPool(std::size_t threadCount){
+    if(threadCount == 0){
+        // leave a hardware thread for the calling thread
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    // a queue for each worker and one shared by the outside threads
+    for(std::size_t i = 0; i < threadCount + 1; i++){
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+
+    for(std::size_t i = 0; i < threadCount; i++){
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for(std::thread& worker : workers){
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task){
+    TaskQueue& queue = *queues[queueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pendingTasks++;
+    }
+    wakeCondition.notify_one();
+}
+
+bool ThreadPool::RunPendingTask(){
+    std::function<void()> task;
+    std::size_t own = queueIndex();
+
+    // take the newest task of the own queue as it is likely still in cache
+    {
+        TaskQueue& queue = *queues[own];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty()){
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    // otherwise steal the oldest task of another queue
+    for(std::size_t i = 1; !task && i < queues.size(); i++){
+        TaskQueue& queue = *queues[(own + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty()){
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if(!task){
+        return false;
+    }
+
+    pendingTasks--;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index){
+    currentPool = this;
+    currentQueue = index;
+
+    while(true){
+        if(RunPendingTask()){
+            continue;
+        }
+
+        // sleep until there are tasks to run
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this](){
+            return stopping || pendingTasks > 0;
+        });
+
+        if(stopping){
+            return;
+        }
+    }
+}
@@ -0,0 +1,292 @@
+#include <engine/quad_batch.hpp>
+
+// include standard library
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/* build quads with SSE2 when it's available at compile time
+    @NOTE: the kernel is bound by the shuffles that load and store quads 4 at a time, so AVX2 builds use it as well
+*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SISTERS_QUAD_SSE2
+    #include <emmintrin.h>
+#endif
+
+QuadInstance QuadInstance::Create(int texIndex, glm::vec2 position, glm::vec2 size, float rotation, glm::vec4 color, glm::vec4 texRect){
+    QuadInstance instance;
+    instance.position = position;
+    instance.size = size;
+
+    // wrap the rotation into [-180, 180) degrees and store it scaled to [-1, 1)
+    float wrapped = rotation - 360.0f * std::floor((rotation + 180.0f) / 360.0f);
+    instance.rotation = (std::int16_t)std::clamp(std::lround(wrapped / 180.0f * 32767.0f), -32767l, 32767l);
+    instance.texIndex = (std::uint16_t)texIndex;
+
+    // pack the color as 8 bit RGBA
+    auto unorm8 = [](float value){
+        return (std::uint32_t)std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+    };
+    instance.color = unorm8(color.x) | (unorm8(color.y) << 8) | (unorm8(color.z) << 16) | (unorm8(color.w) << 24);
+
+    // pack the texture rectangle as 16 bit coordinates
+    for(int i = 0; i < 4; i++){
+        instance.texRect[i] = (std::uint16_t)std::lround(std::clamp(texRect[i], 0.0f, 1.0f) * 65535.0f);
+    }
+
+    return instance;
+}
+
+//* lane types, each one computes the corners of Width quads at once
+
+// a single quad at a time, used for the remaining quads and when no SIMD is available
+struct ScalarLanes{
+    using Type = float;
+    static constexpr int Width = 1;
+
+    static Type Load(const float* values){ return *values; }
+    static Type Set(float value){ return value; }
+    static void Store(float* values, Type a){ *values = a; }
+    static Type Add(Type a, Type b){ return a + b; }
+    static Type Sub(Type a, Type b){ return a - b; }
+    static Type Mul(Type a, Type b){ return a * b; }
+    static Type Min(Type a, Type b){ return std::min(a, b); }
+    static Type Max(Type a, Type b){ return std::max(a, b); }
+
+    // subtract the amount from the values greater than the limit
+    static Type SubAbove(Type a, Type limit, Type amount){ return a > limit ? a - amount : a; }
+};
+
+#if defined(SISTERS_QUAD_SSE2)
+// 4 quads at a time
+struct SIMDLanes{
+    using Type = __m128;
+    static constexpr int Width = 4;
+
+    static Type Load(const float* values){ return _mm_loadu_ps(values); }
+    static Type Set(float value){ return _mm_set1_ps(value); }
+    static void Store(float* values, Type a){ _mm_storeu_ps(values, a); }
+    static Type Add(Type a, Type b){ return _mm_add_ps(a, b); }
+    static Type Sub(Type a, Type b){ return _mm_sub_ps(a, b); }
+    static Type Mul(Type a, Type b){ return _mm_mul_ps(a, b); }
+    static Type Min(Type a, Type b){ return _mm_min_ps(a, b); }
+    static Type Max(Type a, Type b){ return _mm_max_ps(a, b); }
+
+    static Type SubAbove(Type a, Type limit, Type amount){
+        return _mm_sub_ps(a, _mm_and_ps(_mm_cmpgt_ps(a, limit), amount));
+    }
+};
+#endif
+
+/* get sin(pi * t) for t within [-1, 1]
+    @NOTE: t is folded into [-0.5, 0.5] and evaluated with an odd polynomial, accurate to about 1e-7
+*/
+template<typename Lanes>
+static typename Lanes::Type sinPi(typename Lanes::Type t){
+    using L = Lanes;
+
+    // sin(pi * t) == sin(pi * (1 - t)) == sin(pi * (-1 - t))
+    auto folded = L::Min(t, L::Sub(L::Set(1.0f), t));
+    folded = L::Max(folded, L::Sub(L::Set(-1.0f), folded));
+
+    auto x = L::Mul(folded, L::Set(3.14159265f));
+    auto x2 = L::Mul(x, x);
+
+    // taylor series up to x^11
+    auto p = L::Set(-2.50521084e-8f);
+    p = L::Add(L::Mul(p, x2), L::Set(2.75573192e-6f));
+    p = L::Add(L::Mul(p, x2), L::Set(-1.98412698e-4f));
+    p = L::Add(L::Mul(p, x2), L::Set(8.33333333e-3f));
+    p = L::Add(L::Mul(p, x2), L::Set(-1.66666667e-1f));
+    p = L::Add(L::Mul(p, x2), L::Set(1.0f));
+    return L::Mul(p, x);
+}
+
+// write the vertices of Lanes::Width quads, one quad at a time for the remaining quads
+template<typename Lanes>
+static void buildQuads(const QuadInstance* instances, QuadVertex* output){
+    using L = Lanes;
+    constexpr int width = L::Width;
+
+    // gather the transforms of every quad
+    float px[width], py[width], halfWidth[width], halfHeight[width], turns[width];
+    for(int i = 0; i < width; i++){
+        px[i] = instances[i].position.x;
+        py[i] = instances[i].position.y;
+        halfWidth[i] = instances[i].size.x * 0.5f;
+        halfHeight[i] = instances[i].size.y * 0.5f;
+        turns[i] = instances[i].rotation * (1.0f / 32767.0f);
+    }
+
+    // sin and cos once per quad, cos(pi * t) == sin(pi * (t + 0.5)) wrapped back into [-1, 1]
+    auto t = L::Load(turns);
+    auto s = sinPi<L>(t);
+    auto c = sinPi<L>(L::SubAbove(L::Add(t, L::Set(0.5f)), L::Set(1.0f), L::Set(2.0f)));
+
+    // rotated half extents
+    auto hw = L::Load(halfWidth), hh = L::Load(halfHeight);
+    auto a = L::Mul(hw, c), b = L::Mul(hw, s);
+    auto d = L::Mul(hh, s), e = L::Mul(hh, c);
+
+    // corners in the order bottom left, bottom right, top right, top left
+    auto x = L::Load(px), y = L::Load(py);
+    float cornerX[4][width], cornerY[4][width];
+    L::Store(cornerX[0], L::Add(L::Sub(x, a), d));
+    L::Store(cornerY[0], L::Sub(L::Sub(y, b), e));
+    L::Store(cornerX[1], L::Add(L::Add(x, a), d));
+    L::Store(cornerY[1], L::Sub(L::Add(y, b), e));
+    L::Store(cornerX[2], L::Sub(L::Add(x, a), d));
+    L::Store(cornerY[2], L::Add(L::Add(y, b), e));
+    L::Store(cornerX[3], L::Sub(L::Sub(x, a), d));
+    L::Store(cornerY[3], L::Add(L::Sub(y, b), e));
+
+    // write the vertices of each quad
+    for(int i = 0; i < width; i++){
+        const QuadInstance& instance = instances[i];
+
+        std::uint32_t packed = instance.color;
+        glm::vec4 color(
+            (float)(packed & 0xff) * (1.0f / 255.0f),
+            (float)((packed >> 8) & 0xff) * (1.0f / 255.0f),
+            (float)((packed >> 16) & 0xff) * (1.0f / 255.0f),
+            (float)(packed >> 24) * (1.0f / 255.0f));
+
+        float u0 = instance.texRect[0] * (1.0f / 65535.0f), v0 = instance.texRect[1] * (1.0f / 65535.0f);
+        float u1 = instance.texRect[2] * (1.0f / 65535.0f), v1 = instance.texRect[3] * (1.0f / 65535.0f);
+        const glm::vec2 texCoords[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+        float texIndex = (float)instance.texIndex;
+
+        for(int corner = 0; corner < 4; corner++){
+            output->position = glm::vec2(cornerX[corner][i], cornerY[corner][i]);
+            output->texCoords = texCoords[corner];
+            output->texIndex = texIndex;
+            output->color = color;
+            output++;
+        }
+    }
+}
+
+#if defined(SISTERS_QUAD_SSE2)
+static_assert(offsetof(QuadInstance, rotation) == 16, "ERROR: The packed half of a quad instance must start at its 16th byte");
+static_assert(sizeof(QuadVertex) == 9 * sizeof(float), "ERROR: A quad vertex must be 9 packed floats");
+
+// attributes of 4 quads, one quad per lane
+struct QuadGroup{
+    __m128 x, y, halfWidth, halfHeight, turns;
+    __m128 texIndex, u0, v0, u1, v1;
+    __m128 r, g, b, a;
+};
+
+// load the attributes of 4 quads with two loads per quad and a transpose of each half
+static QuadGroup loadQuadGroup(const QuadInstance* instances){
+    __m128 f0 = _mm_loadu_ps(&instances[0].position.x), f1 = _mm_loadu_ps(&instances[1].position.x);
+    __m128 f2 = _mm_loadu_ps(&instances[2].position.x), f3 = _mm_loadu_ps(&instances[3].position.x);
+    _MM_TRANSPOSE4_PS(f0, f1, f2, f3);
+
+    // the packed half is moved as raw bits, then unpacked as integers
+    __m128 p0 = _mm_loadu_ps(reinterpret_cast<const float*>(&instances[0].rotation)), p1 = _mm_loadu_ps(reinterpret_cast<const float*>(&instances[1].rotation));
+    __m128 p2 = _mm_loadu_ps(reinterpret_cast<const float*>(&instances[2].rotation)), p3 = _mm_loadu_ps(reinterpret_cast<const float*>(&instances[3].rotation));
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    __m128i rotationTexture = _mm_castps_si128(p0), color = _mm_castps_si128(p1);
+    __m128i rect01 = _mm_castps_si128(p2), rect23 = _mm_castps_si128(p3);
+
+    const __m128i low16 = _mm_set1_epi32(0xffff), low8 = _mm_set1_epi32(0xff);
+    const __m128 unorm8 = _mm_set1_ps(1.0f / 255.0f), unorm16 = _mm_set1_ps(1.0f / 65535.0f);
+
+    QuadGroup group;
+    group.x = f0;
+    group.y = f1;
+    group.halfWidth = _mm_mul_ps(f2, _mm_set1_ps(0.5f));
+    group.halfHeight = _mm_mul_ps(f3, _mm_set1_ps(0.5f));
+
+    // the rotation is the signed low half, the texture index the unsigned high half
+    group.turns = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(rotationTexture, 16), 16)), _mm_set1_ps(1.0f / 32767.0f));
+    group.texIndex = _mm_cvtepi32_ps(_mm_srli_epi32(rotationTexture, 16));
+
+    group.u0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(rect01, low16)), unorm16);
+    group.v0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(rect01, 16)), unorm16);
+    group.u1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(rect23, low16)), unorm16);
+    group.v1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(rect23, 16)), unorm16);
+
+    group.r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(color, low8)), unorm8);
+    group.g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(color, 8), low8)), unorm8);
+    group.b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(color, 16), low8)), unorm8);
+    group.a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(color, 24)), unorm8);
+    return group;
+}
+
+/* write the vertices of 4 quads, the lanes are transposed so every vertex is written with two 16 byte stores and one 4 byte store
+    @NOTE: the stores never overlap, so the output can be write combined memory
+*/
+static void storeQuadGroup(const QuadGroup& group, const __m128 cornerX[4], const __m128 cornerY[4], QuadVertex* output){
+    // texture index and the first three color channels are the same for every corner of a quad
+    __m128 shared[4] = {group.texIndex, group.r, group.g, group.b};
+    _MM_TRANSPOSE4_PS(shared[0], shared[1], shared[2], shared[3]);
+
+    __m128 alpha[4] = {
+        group.a,
+        _mm_shuffle_ps(group.a, group.a, _MM_SHUFFLE(1, 1, 1, 1)),
+        _mm_shuffle_ps(group.a, group.a, _MM_SHUFFLE(2, 2, 2, 2)),
+        _mm_shuffle_ps(group.a, group.a, _MM_SHUFFLE(3, 3, 3, 3))};
+
+    // position and texture coordinates of each corner, in the order bottom left, bottom right, top right, top left
+    const __m128 u[4] = {group.u0, group.u1, group.u1, group.u0};
+    const __m128 v[4] = {group.v0, group.v0, group.v1, group.v1};
+    __m128 corners[4][4];
+    for(int corner = 0; corner < 4; corner++){
+        __m128 c0 = cornerX[corner], c1 = cornerY[corner], c2 = u[corner], c3 = v[corner];
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        corners[corner][0] = c0;
+        corners[corner][1] = c1;
+        corners[corner][2] = c2;
+        corners[corner][3] = c3;
+    }
+
+    float* out = reinterpret_cast<float*>(output);
+    for(int quad = 0; quad < 4; quad++){
+        for(int corner = 0; corner < 4; corner++){
+            _mm_storeu_ps(out, corners[corner][quad]);
+            _mm_storeu_ps(out + 4, shared[quad]);
+            _mm_store_ss(out + 8, alpha[quad]);
+            out += 9;
+        }
+    }
+}
+
+// write the vertices of 4 quads, with every attribute loaded, converted, and stored 4 quads at a time
+static void buildQuadsSIMD(const QuadInstance* instances, QuadVertex* output){
+    using L = SIMDLanes;
+    QuadGroup group = loadQuadGroup(instances);
+
+    // sin and cos once per quad, cos(pi * t) == sin(pi * (t + 0.5)) wrapped back into [-1, 1]
+    auto s = sinPi<L>(group.turns);
+    auto c = sinPi<L>(L::SubAbove(L::Add(group.turns, L::Set(0.5f)), L::Set(1.0f), L::Set(2.0f)));
+
+    // rotated half extents
+    auto a = L::Mul(group.halfWidth, c), b = L::Mul(group.halfWidth, s);
+    auto d = L::Mul(group.halfHeight, s), e = L::Mul(group.halfHeight, c);
+
+    // corners in the order bottom left, bottom right, top right, top left
+    auto x = group.x, y = group.y;
+    const __m128 cornerX[4] = {L::Add(L::Sub(x, a), d), L::Add(L::Add(x, a), d), L::Sub(L::Add(x, a), d), L::Sub(L::Sub(x, a), d)};
+    const __m128 cornerY[4] = {L::Sub(L::Sub(y, b), e), L::Sub(L::Add(y, b), e), L::Add(L::Add(y, b), e), L::Add(L::Sub(y, b), e)};
+
+    storeQuadGroup(group, cornerX, cornerY, output);
+}
+#endif
+
+void BuildQuadVertices(std::span<const QuadInstance> instances, QuadVertex* output){
+    std::size_t i = 0;
+
+#if defined(SISTERS_QUAD_SSE2)
+    for(; i + SIMDLanes::Width <= instances.size(); i += SIMDLanes::Width){
+        buildQuadsSIMD(instances.data() + i, output + i * 4);
+    }
+#endif
+
+    // remaining quads
+    for(; i < instances.size(); i++){
+        buildQuads<ScalarLanes>(instances.data() + i, output + i * 4);
+    }
+}
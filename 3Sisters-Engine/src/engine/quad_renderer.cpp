@@ -4,9 +4,13 @@
 #include <iostream>
 
 // include additional GLM library
-#include <glm/ext/matrix_transform.hpp>
 #include <glm/trigonometric.hpp>
 
+// include standard library
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 // initialize static variables
 const glm::vec4                     QuadRenderer::quadVertexPositions[4] = {
     {-0.5f, -0.5f, 0.0f, 1.0f},
@@ -22,6 +26,14 @@ const std::array<glm::vec2, 4>      QuadRenderer::textureCoordinates = {{
 // initialize quad buffer
 QuadRenderer::QuadVertex*             QuadRenderer::quadBuffer = nullptr;
 QuadRenderer::QuadVertex*             QuadRenderer::quadBufferPtr = nullptr;
+QuadRenderer::QuadVertex*             QuadRenderer::quadBufferEnd = nullptr;
+
+// initialize persistent mapping data
+bool                                QuadRenderer::isPersistent = false;
+QuadRenderer::QuadVertex*             QuadRenderer::quadMapped = nullptr;
+int                                 QuadRenderer::quadSegment = 0;
+int                                 QuadRenderer::quadSegmentOffset = 0;
+GLsync                              QuadRenderer::quadFences[quadSegmentCount] = {};
 
 // initialize quad graphics data
 unsigned int                        QuadRenderer::quadVAO;
@@ -29,12 +41,19 @@ unsigned int                        QuadRenderer::quadVBO;
 unsigned int                        QuadRenderer::quadEBO;
 unsigned int                        QuadRenderer::quadIndexCount;
 
+// initialize instancing data
+Shader                              QuadRenderer::instanceShader;
+unsigned int                        QuadRenderer::instanceVAO = 0;
+unsigned int                        QuadRenderer::instanceVBO = 0;
+QuadRenderer::QuadInstance*           QuadRenderer::instanceBuffer = nullptr;
+int                                 QuadRenderer::instanceCount = 0;
+
 // initialize changeable shader
 Shader                              QuadRenderer::quadShader;
 // initialize auto clear var
 bool                                QuadRenderer::isAutoClearSet = false;
 
-void QuadRenderer::Init(Shader& s){
+void QuadRenderer::Init(Shader& s, bool persistentMapping){
     // when auto clear is set, stop re-initializing rendering data
     if(isAutoClearSet){
         std::cout << "Warning: Initialization of Sprite Renderer being called more than once!\n";
@@ -48,10 +67,62 @@ void QuadRenderer::Init(Shader& s){
     quadShader = s;
 
     // set up shader samples for the quad textures
-    quadShader.Use();
+    setUpSamplers(quadShader);
+
+    // set up rendering of quads
+    initQuadRenderData(persistentMapping); 
+}
+
+void QuadRenderer::InitInstancing(Shader& s){
+    //? check if the quad renderer hasn't been set up
+    if(quadBuffer == nullptr){
+        //! Display error
+        std::cout << "ERROR: Missing quad render initialization before instancing initialization!\n";
+        return; // stop function
+    }
+
+    //? check if instancing was already set up
+    if(instanceBuffer != nullptr){
+        std::cout << "Warning: Initialization of quad instancing being called more than once!\n";
+        return;
+    }
+
+    // set the shader reference
+    instanceShader = s;
+
+    // set up shader samples for the quad textures
+    setUpSamplers(instanceShader);
+
+    // set up rendering of quad instances
+    initInstanceRenderData();
+}
+
+void QuadRenderer::setUpSamplers(Shader& shader){
+    shader.Use();
     
     // grab the uniform location of 'image' in the shader, the name 'image' is explicit
-    auto loc = glGetUniformLocation(quadShader.getID(), "image");
+    auto loc = glGetUniformLocation(shader.getID(), "image");
+
+    // bindless shaders read their textures from a storage buffer instead
+    if(loc < 0){
+        return;
+    }
+
+    // find out the type and size of the sampler
+    const char* name = "image";
+    GLuint index;
+    glGetUniformIndices(shader.getID(), 1, &name, &index);
+
+    GLint size = maxTextureSlots;
+    GLenum type = GL_SAMPLER_2D;
+    char unused[8];
+    glGetActiveUniform(shader.getID(), index, sizeof(unused), nullptr, &size, &type, unused);
+
+    // a texture array is a single sampler on its own unit
+    if(type == GL_SAMPLER_2D_ARRAY){
+        glUniform1i(loc, textureArrayUnit);
+        return;
+    }
 
     // set up array to the size of the max number of textures
     int samplers[maxTextureSlots];
@@ -62,11 +133,27 @@ void QuadRenderer::Init(Shader& s){
         samplers[i] = i;
     }
 
-    // set up the index of the shader's texture array
-    glUniform1iv(loc, maxTextureSlots, samplers);
+    // set up the index of the shader's texture array, shaders may have fewer samplers
+    glUniform1iv(loc, std::min((int)size, (int)maxTextureSlots), samplers);
+}
 
-    // set up rendering of quads
-    initQuadRenderData(); 
+void QuadRenderer::UseTextureArray(TextureArray& textures){
+    // render what was stored with the previous textures
+    if(quadBufferPtr != nullptr){
+        FlushQuads();
+    }
+    if(instanceBuffer != nullptr){
+        FlushQuadInstances();
+    }
+
+    // check opengl version
+    if(GLAD_GL_VERSION_4_5){
+        glBindTextureUnit(textureArrayUnit, textures.GetID());
+    }else{
+        glActiveTexture(GL_TEXTURE0 + textureArrayUnit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures.GetID());
+        glActiveTexture(GL_TEXTURE0);
+    }
 }
 
 void QuadRenderer::DrawQuad(int texIndex, glm::vec2 pos, glm::vec2 size, float rot, glm::vec4 color,const std::array<glm::vec2, 4> texCoords ,const glm::vec4 vertexPositions[]){
@@ -107,6 +194,95 @@ void QuadRenderer::StackQuad(int texIndex, glm::vec2 pos, glm::vec2 size, float
     createQuad(pos, size, rot, texIndex, color, texCoords, vertexPositions);
 }
 
+void QuadRenderer::StackQuads(std::span<const QuadInstance> quads){
+    //? check if buffer hasn't been set up
+    if(quadBuffer == nullptr){
+        //! Display error
+        std::cout << "ERROR: Missing quad render buffer initialization!\n";
+        return; // stop function
+    }
+
+    // check if the buffer pointer hasn't been set up
+    if(quadBufferPtr == nullptr){
+        // then initialize the batch
+        beginQuadBatch();
+    }
+
+    // build the quads straight into the batch, flushing whenever it is full
+    while(!quads.empty()){
+        if(quadBufferPtr >= quadBufferEnd){
+            FlushQuads();
+            beginQuadBatch();
+        }
+
+        std::size_t amount = std::min(quads.size(), (std::size_t)(quadBufferEnd - quadBufferPtr) / 4);
+        BuildQuadVertices(quads.first(amount), quadBufferPtr);
+        quadBufferPtr += amount * 4;
+        quadIndexCount += amount * 6;
+        quads = quads.subspan(amount);
+    }
+}
+
+void QuadRenderer::StackQuadInstance(const QuadInstance& instance){
+    StackQuadInstances(std::span<const QuadInstance>(&instance, 1));
+}
+
+void QuadRenderer::StackQuadInstances(std::span<const QuadInstance> instances){
+    //? check if buffer hasn't been set up
+    if(instanceBuffer == nullptr){
+        //! Display error
+        std::cout << "ERROR: Missing quad instancing initialization!\n";
+        return; // stop function
+    }
+
+    // copy the instances as is, flushing whenever the buffer is full
+    while(!instances.empty()){
+        if(instanceCount >= maxQuadCount){
+            FlushQuadInstances();
+        }
+
+        std::size_t amount = std::min(instances.size(), (std::size_t)(maxQuadCount - instanceCount));
+        std::memcpy(instanceBuffer + instanceCount, instances.data(), amount * sizeof(QuadInstance));
+        instanceCount += (int)amount;
+        instances = instances.subspan(amount);
+    }
+}
+
+void QuadRenderer::FlushQuadInstances(){
+    //? check if buffer hasn't been set up
+    if(instanceBuffer == nullptr){
+        //! Display error
+        std::cout << "ERROR: Missing quad instancing initialization!\n";
+        return; // stop function
+    }
+
+    if(instanceCount == 0){
+        // there are no instances to render
+        return; // stop function
+    }
+
+    // check opengl version, the buffer is orphaned first so the upload doesn't wait on draws still reading it
+    GLsizeiptr size = sizeof(QuadInstance) * instanceCount;
+    if(GLAD_GL_VERSION_4_5){
+        glNamedBufferData(instanceVBO, sizeof(QuadInstance) * maxQuadCount, nullptr, GL_DYNAMIC_DRAW);
+        glNamedBufferSubData(instanceVBO, 0, size, instanceBuffer);
+    }else{
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(QuadInstance) * maxQuadCount, nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, instanceBuffer);
+    }
+
+    // ensure shader usage
+    instanceShader.Use();
+
+    // draw every instance from the first quad's six indices, the corners are built within the vertex shader
+    glBindVertexArray(instanceVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, instanceCount);
+
+    // reset instance count
+    instanceCount = 0;
+}
+
 void QuadRenderer::FlushQuads(){
     //? check if buffer hasn't been set up
     if(quadBuffer == nullptr){
@@ -129,7 +305,19 @@ void QuadRenderer::FlushQuads(){
 
     // draw the quad/s
     glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, quadIndexCount, GL_UNSIGNED_INT, nullptr);
+    if(isPersistent){
+        // the batch starts within the current segment of the mapped buffer
+        glDrawElementsBaseVertex(GL_TRIANGLES, quadIndexCount, GL_UNSIGNED_INT, nullptr, quadSegment * maxQuadVertexCount + quadSegmentOffset);
+        quadSegmentOffset += quadBufferPtr - quadBuffer;
+
+        // fence the segment so it isn't written into again until the GPU is done reading it
+        if(quadFences[quadSegment] != nullptr){
+            glDeleteSync(quadFences[quadSegment]);
+        }
+        quadFences[quadSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }else{
+        glDrawElements(GL_TRIANGLES, quadIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
 
     // reset buffer pointer
     quadBufferPtr = nullptr;
@@ -139,53 +327,47 @@ void QuadRenderer::FlushQuads(){
 }
 
 void QuadRenderer::createQuad(glm::vec2& pos, glm::vec2& size, float& rotation, int& texIndex, glm::vec4& color, const std::array<glm::vec2, 4> texCoords,const glm::vec4 vertexPositions[]){
-    // check if not over the index count
-    if (quadIndexCount >= maxQuadIndexCount){
+    // check if the batch's memory is full
+    if (quadBufferPtr >= quadBufferEnd){
         // flush what's left and start another batch
         FlushQuads();  
         beginQuadBatch();
     }
 
-    // create model transform
-    glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(pos, 0.0f)) 
-    * glm::rotate(glm::mat4(1.0f), glm::radians(rotation), {0.0f, 0.0f, 1.0f}) 
-    * glm::scale(glm::mat4(1.0f), {size.x, size.y, 0.0f});
-
-    quadBufferPtr->position = (transform * vertexPositions[0]);
-    quadBufferPtr->texCoords = texCoords[0];
-    quadBufferPtr->texIndex = texIndex;
-    quadBufferPtr->color = color;
-    quadBufferPtr++;
-
-    quadBufferPtr->position = (transform * vertexPositions[1]);
-    quadBufferPtr->texCoords = texCoords[1];
-    quadBufferPtr->texIndex = texIndex;
-    quadBufferPtr->color = color;
-    quadBufferPtr++;
+    // rotate and scale each corner directly in 2D, the vertex's w scales the translation
+    float radians = glm::radians(rotation);
+    float c = std::cos(radians), s = std::sin(radians);
 
-    quadBufferPtr->position = (transform * vertexPositions[2]);
-    quadBufferPtr->texCoords = texCoords[2];
-    quadBufferPtr->texIndex = texIndex;
-    quadBufferPtr->color = color;
-    quadBufferPtr++;
+    for(int i = 0; i < 4; i++){
+        float x = vertexPositions[i].x * size.x, y = vertexPositions[i].y * size.y;
 
-    quadBufferPtr->position = (transform * vertexPositions[3]);
-    quadBufferPtr->texCoords = texCoords[3];
-    quadBufferPtr->texIndex = texIndex;
-    quadBufferPtr->color = color;
-    quadBufferPtr++;
+        quadBufferPtr->position = glm::vec2(c * x - s * y, s * x + c * y) + pos * vertexPositions[i].w;
+        quadBufferPtr->texCoords = texCoords[i];
+        quadBufferPtr->texIndex = texIndex;
+        quadBufferPtr->color = color;
+        quadBufferPtr++;
+    }
 
     quadIndexCount += 6;
 }
 
 // Set up the quad rendering
-void QuadRenderer::initQuadRenderData(){
+void QuadRenderer::initQuadRenderData(bool persistentMapping){
     // check if quad buffer had already been initialized
     if (quadBuffer != nullptr)
         exit(-1); // avoid re-initalize of the render data
 
+    // persistent mapping requires buffer storage, OpenGL 4.4+
+    isPersistent = persistentMapping && (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage);
+
+    // the mapped buffer holds a segment for each batch in flight, quads are written straight into it
+    GLsizeiptr vertexBufferSize = sizeof(QuadVertex) * maxQuadVertexCount * (isPersistent ? quadSegmentCount : 1);
+    GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
     // configure buffer
-    quadBuffer = new QuadVertex[maxQuadVertexCount];
+    if(!isPersistent){
+        quadBuffer = new QuadVertex[maxQuadVertexCount];
+    }
 
     // indices buffer data
     unsigned int indices[maxQuadIndexCount];
@@ -209,7 +391,12 @@ void QuadRenderer::initQuadRenderData(){
         glCreateBuffers(1, &quadVBO);
         glCreateBuffers(1, &quadEBO);
 
-        glNamedBufferData(quadVBO, sizeof(QuadVertex) * maxQuadVertexCount, nullptr, GL_DYNAMIC_DRAW);
+        if(isPersistent){
+            glNamedBufferStorage(quadVBO, vertexBufferSize, nullptr, mapFlags);
+            quadMapped = (QuadVertex*)glMapNamedBufferRange(quadVBO, 0, vertexBufferSize, mapFlags);
+        }else{
+            glNamedBufferData(quadVBO, vertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+        }
         glNamedBufferData(quadEBO, sizeof(indices), indices, GL_STATIC_DRAW);
 
         glVertexArrayVertexBuffer(quadVAO, 0, quadVBO, 0, sizeof(QuadVertex));
@@ -242,7 +429,12 @@ void QuadRenderer::initQuadRenderData(){
         glBindVertexArray(quadVAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(QuadVertex) * maxQuadVertexCount, nullptr, GL_DYNAMIC_DRAW);
+        if(isPersistent){
+            glBufferStorage(GL_ARRAY_BUFFER, vertexBufferSize, nullptr, mapFlags);
+            quadMapped = (QuadVertex*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBufferSize, mapFlags);
+        }else{
+            glBufferData(GL_ARRAY_BUFFER, vertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+        }
 
         // vertex attribute
         glEnableVertexAttribArray(0);
@@ -264,9 +456,141 @@ void QuadRenderer::initQuadRenderData(){
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
     }
+
+    if(isPersistent){
+        //? check if the buffer couldn't be mapped
+        if(quadMapped == nullptr){
+            //! Display error
+            std::cout << "ERROR: Failed to persistently map the quad vertex buffer!\n";
+            exit(-1);
+        }
+
+        // batches start in the first segment
+        quadBuffer = quadMapped;
+        quadSegment = 0;
+        quadSegmentOffset = 0;
+    }
+}
+
+// Set up the quad instance rendering
+void QuadRenderer::initInstanceRenderData(){
+    // configure buffer
+    instanceBuffer = new QuadInstance[maxQuadCount];
+
+    // check opengl version
+    if(GLAD_GL_VERSION_4_5){
+        // configure VAO/VBO, the EBO is shared with the quads
+        glCreateVertexArrays(1, &instanceVAO);
+        glCreateBuffers(1, &instanceVBO);
+
+        glNamedBufferData(instanceVBO, sizeof(QuadInstance) * maxQuadCount, nullptr, GL_DYNAMIC_DRAW);
+
+        glVertexArrayVertexBuffer(instanceVAO, 0, instanceVBO, 0, sizeof(QuadInstance));
+        glVertexArrayBindingDivisor(instanceVAO, 0, 1);
+        glVertexArrayElementBuffer(instanceVAO, quadEBO);
+
+        // position attribute
+        glEnableVertexArrayAttrib(instanceVAO, 0);
+        glVertexArrayAttribBinding(instanceVAO, 0, 0);
+        glVertexArrayAttribFormat(instanceVAO, 0, 2, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, position));
+
+        // size attribute
+        glEnableVertexArrayAttrib(instanceVAO, 1);
+        glVertexArrayAttribBinding(instanceVAO, 1, 0);
+        glVertexArrayAttribFormat(instanceVAO, 1, 2, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, size));
+
+        // rotation attribute
+        glEnableVertexArrayAttrib(instanceVAO, 2);
+        glVertexArrayAttribBinding(instanceVAO, 2, 0);
+        glVertexArrayAttribFormat(instanceVAO, 2, 1, GL_SHORT, GL_TRUE, offsetof(QuadInstance, rotation));
+
+        // texture index attribute
+        glEnableVertexArrayAttrib(instanceVAO, 3);
+        glVertexArrayAttribBinding(instanceVAO, 3, 0);
+        glVertexArrayAttribFormat(instanceVAO, 3, 1, GL_UNSIGNED_SHORT, GL_FALSE, offsetof(QuadInstance, texIndex));
+
+        // color attribute
+        glEnableVertexArrayAttrib(instanceVAO, 4);
+        glVertexArrayAttribBinding(instanceVAO, 4, 0);
+        glVertexArrayAttribFormat(instanceVAO, 4, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(QuadInstance, color));
+
+        // texture rectangle attribute
+        glEnableVertexArrayAttrib(instanceVAO, 5);
+        glVertexArrayAttribBinding(instanceVAO, 5, 0);
+        glVertexArrayAttribFormat(instanceVAO, 5, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(QuadInstance, texRect));
+    }else{
+        // configure VAO/VBO, the EBO is shared with the quads
+        glGenVertexArrays(1, &instanceVAO);
+        glGenBuffers(1, &instanceVBO);
+
+        glBindVertexArray(instanceVAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(QuadInstance) * maxQuadCount, nullptr, GL_DYNAMIC_DRAW);
+
+        // position attribute
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, position));
+        glVertexAttribDivisor(0, 1);
+
+        // size attribute
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, size));
+        glVertexAttribDivisor(1, 1);
+
+        // rotation attribute
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 1, GL_SHORT, GL_TRUE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, rotation));
+        glVertexAttribDivisor(2, 1);
+
+        // texture index attribute
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, texIndex));
+        glVertexAttribDivisor(3, 1);
+
+        // color attribute
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, color));
+        glVertexAttribDivisor(4, 1);
+
+        // texture rectangle attribute
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuadInstance), (const void *)offsetof(QuadInstance, texRect));
+        glVertexAttribDivisor(5, 1);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    }
+}
+
+void QuadRenderer::nextQuadSegment(){
+    quadSegment = (quadSegment + 1) % quadSegmentCount;
+    quadSegmentOffset = 0;
+
+    // wait for the GPU to finish reading the segment's previous quads
+    if(quadFences[quadSegment] != nullptr){
+        GLenum result;
+        do{
+            result = glClientWaitSync(quadFences[quadSegment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }while(result == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(quadFences[quadSegment]);
+        quadFences[quadSegment] = nullptr;
+    }
 }
 
 void QuadRenderer::beginQuadBatch(){
+    if(isPersistent){
+        // continue within the current segment, moving onto the next one once it's full
+        if(quadSegmentOffset >= maxQuadVertexCount){
+            nextQuadSegment();
+        }
+
+        quadBuffer = quadMapped + quadSegment * maxQuadVertexCount + quadSegmentOffset;
+        quadBufferEnd = quadMapped + (quadSegment + 1) * maxQuadVertexCount;
+    }else{
+        quadBufferEnd = quadBuffer + maxQuadVertexCount;
+    }
+
     // set buffer pointer
     quadBufferPtr = quadBuffer;
 
@@ -277,18 +601,25 @@ void QuadRenderer::beginQuadBatch(){
 bool QuadRenderer::endQuadBatch(){
     // calculate amount of quads to render
     GLsizeiptr size = (uint8_t*)quadBufferPtr - (uint8_t*)quadBuffer;
-    if(size < 0){
+    if(size <= 0){
         // no quads available
         return false;
     }
 
-    // check opengl version
+    // quads were written straight into the mapped buffer, which is coherent
+    if(isPersistent){
+        return true;
+    }
+
+    // check opengl version, the buffer is orphaned first so the upload doesn't wait on draws still reading it
     if(GLAD_GL_VERSION_4_5){
         // set up dynamic buffer
+        glNamedBufferData(quadVBO, sizeof(QuadVertex) * maxQuadVertexCount, nullptr, GL_DYNAMIC_DRAW);
         glNamedBufferSubData(quadVBO, 0, size, quadBuffer);
     }else{
         // set up dynamic buffer
         glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(QuadVertex) * maxQuadVertexCount, nullptr, GL_DYNAMIC_DRAW);
         glBufferSubData(GL_ARRAY_BUFFER, 0, size, quadBuffer);
     }
 
@@ -298,10 +629,30 @@ bool QuadRenderer::endQuadBatch(){
 
 void QuadRenderer::clear(){
     // delete all quad buffers
-    delete[] quadBuffer;
+    if(isPersistent){
+        // the buffer is unmapped once deleted, only the fences need to be deleted
+        for(GLsync& fence : quadFences){
+            if(fence != nullptr){
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        quadMapped = nullptr;
+    }else{
+        delete[] quadBuffer;
+    }
+    quadBuffer = nullptr;
     quadBufferPtr = nullptr;
     delete quadBufferPtr;
 
+    // delete quad instance data
+    if(instanceBuffer != nullptr){
+        delete[] instanceBuffer;
+        instanceBuffer = nullptr;
+        glDeleteVertexArrays(1, &instanceVAO);
+        glDeleteBuffers(1, &instanceVBO);
+    }
+
     // delete quad buffer data
     glDeleteVertexArrays(1, &quadVAO);
     glDeleteBuffers(1, &quadVBO);
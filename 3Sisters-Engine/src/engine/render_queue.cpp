@@ -0,0 +1,169 @@
+#include <engine/render_queue.hpp>
+
+// include the renderers
+#include <engine/line_renderer.hpp>
+#include <engine/quad_renderer.hpp>
+#include <engine/text_renderer.hpp>
+
+// include standard library
+#include <algorithm>
+#include <cstring>
+
+// initialize static variables
+std::vector<RenderQueue::SortEntry>         RenderQueue::entries;
+std::vector<RenderQueue::SortEntry>         RenderQueue::sortBuffer;
+std::vector<QuadInstance>                   RenderQueue::quads;
+std::vector<RenderQueue::LineSubmission>    RenderQueue::lines;
+std::vector<RenderQueue::TextSubmission>    RenderQueue::texts;
+std::vector<CharacterSet*>                  RenderQueue::fonts;
+std::vector<QuadInstance>                   RenderQueue::quadRun;
+
+void RenderQueue::SubmitQuad(int layer, int texIndex, glm::vec2 position, glm::vec2 size, float rotation, glm::vec4 color, float depth, glm::vec4 texRect){
+    SubmitQuad(layer, QuadInstance::Create(texIndex, position, size, rotation, color, texRect), depth);
+}
+
+void RenderQueue::SubmitQuad(int layer, const QuadInstance& quad, float depth){
+    entries.push_back({createKey(layer, KIND_QUAD, quad.texIndex, depth), (std::uint32_t)quads.size()});
+    quads.push_back(quad);
+}
+
+void RenderQueue::SubmitQuads(int layer, std::span<const QuadInstance> submitted, float depth){
+    for(const QuadInstance& quad : submitted){
+        SubmitQuad(layer, quad, depth);
+    }
+}
+
+void RenderQueue::SubmitLine(int layer, glm::vec2 p0, glm::vec2 p1, glm::vec4 color, float depth){
+    entries.push_back({createKey(layer, KIND_LINE, 0, depth), (std::uint32_t)lines.size()});
+    lines.push_back({p0, p1, color});
+}
+
+void RenderQueue::SubmitText(int layer, CharacterSet& set, std::string text, glm::vec3 position, float rotation, float size, glm::vec4 color){
+    // text of the same font is kept together, so the font is only bound once
+    auto font = std::find(fonts.begin(), fonts.end(), &set);
+    if(font == fonts.end()){
+        font = fonts.insert(fonts.end(), &set);
+    }
+
+    entries.push_back({createKey(layer, KIND_TEXT, (std::uint32_t)(font - fonts.begin()), position.z), (std::uint32_t)texts.size()});
+    texts.push_back({&set, std::move(text), position, rotation, size, color});
+}
+
+void RenderQueue::Flush(){
+    if(entries.empty()){
+        // nothing was submitted
+        return; // stop function
+    }
+
+    sortEntries();
+
+    // stack every submission in order, a renderer is only flushed when another kind follows it
+    int current = -1;
+    for(std::size_t i = 0; i < entries.size(); i++){
+        Kind kind = kindOf(entries[i].key);
+        if(kind != current && current != -1){
+            flushKind((Kind)current);
+        }
+        current = kind;
+
+        switch(kind){
+            case KIND_QUAD:{
+                // gather consecutive quads, they're built together by StackQuads()
+                quadRun.clear();
+                for(; i < entries.size() && kindOf(entries[i].key) == KIND_QUAD; i++){
+                    quadRun.push_back(quads[entries[i].index]);
+                }
+                i--;
+                QuadRenderer::StackQuads(quadRun);
+                break;
+            }
+            case KIND_LINE:{
+                LineSubmission& line = lines[entries[i].index];
+                LineRenderer::StackLine(line.p0, line.p1, line.color);
+                break;
+            }
+            case KIND_TEXT:{
+                // the text renderer flushes by itself whenever the font changes
+                TextSubmission& text = texts[entries[i].index];
+                TextRenderer::StackCharacters(*text.set, text.text, text.position, text.rotation, text.size, text.color);
+                break;
+            }
+        }
+    }
+    flushKind((Kind)current);
+
+    // empty the queue, keeping the memory for the next frame
+    entries.clear();
+    quads.clear();
+    lines.clear();
+    texts.clear();
+    fonts.clear();
+}
+
+std::size_t RenderQueue::GetSubmissionCount(){
+    return entries.size();
+}
+
+std::uint64_t RenderQueue::createKey(int layer, Kind kind, std::uint32_t texture, float depth){
+    // offset the layer so negative layers are sorted before positive ones
+    std::uint64_t layerBits = (std::uint64_t)(std::clamp(layer, -32768, 32767) + 32768);
+
+    // flip the bits of the depth so it sorts as an unsigned integer, only the top 24 bits are kept
+    std::uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(float));
+    depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+
+    return (layerBits << layerShift) | ((std::uint64_t)kind << kindShift) | ((std::uint64_t)(texture & 0xffff) << textureShift) | (depthBits >> 8);
+}
+
+RenderQueue::Kind RenderQueue::kindOf(std::uint64_t key){
+    return (Kind)((key >> kindShift) & 0xff);
+}
+
+void RenderQueue::sortEntries(){
+    // count the bytes of every key at once
+    std::size_t counts[8][256] = {};
+    for(const SortEntry& entry : entries){
+        for(int pass = 0; pass < 8; pass++){
+            counts[pass][(entry.key >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    // least significant byte first, every pass is stable
+    sortBuffer.resize(entries.size());
+    for(int pass = 0; pass < 8; pass++){
+        std::size_t* count = counts[pass];
+
+        // skip bytes that are the same for every key, such as unused layers or textures
+        if(count[(entries[0].key >> (pass * 8)) & 0xff] == entries.size()){
+            continue;
+        }
+
+        // turn the counts into the starting offsets of each byte
+        std::size_t offset = 0;
+        for(int i = 0; i < 256; i++){
+            std::size_t amount = count[i];
+            count[i] = offset;
+            offset += amount;
+        }
+
+        for(const SortEntry& entry : entries){
+            sortBuffer[count[(entry.key >> (pass * 8)) & 0xff]++] = entry;
+        }
+        entries.swap(sortBuffer);
+    }
+}
+
+void RenderQueue::flushKind(Kind kind){
+    switch(kind){
+        case KIND_QUAD:
+            QuadRenderer::FlushQuads();
+            break;
+        case KIND_LINE:
+            LineRenderer::FlushLines();
+            break;
+        case KIND_TEXT:
+            TextRenderer::FlushText();
+            break;
+    }
+}
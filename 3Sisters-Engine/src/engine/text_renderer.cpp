@@ -6,10 +6,6 @@
 // standard library for debug outputs
 #include <iostream>
 
-// include TextureManager
-#include <resourceSystems/managers/texture_manager.hpp>
-
-
 #include <cstddef>
 
 // initialize static variables
@@ -18,6 +14,7 @@ const int TextRenderer::order[6] = { 0, 1, 2, 0, 2, 3 };
 // init character vertex buffers
 TextRenderer::CharacterVertex*      TextRenderer::characterVertexBuffer = nullptr;
 TextRenderer::CharacterVertex*      TextRenderer::characterVertexBufferPtr = nullptr;
+CharacterSet*                       TextRenderer::characterSet = nullptr;
 
 // init character graphics data
 unsigned int    TextRenderer::VAO;
@@ -28,6 +25,9 @@ unsigned int    TextRenderer::window_height = 0;
 // initialize changeable shader
 Shader          TextRenderer::textShader;
 
+// initialize the font texture unit, set up in Init()
+int             TextRenderer::fontTextureUnit = quadTextureUnits;
+
 // initialize auto clear var
 bool            TextRenderer::isAutoClearSet = false;
 
@@ -49,10 +49,20 @@ void TextRenderer::Init(Shader& shader, unsigned int height){
     // set shader
     textShader = shader;
     
+    // use the first unit after the quad textures, or the last unit when there are no more
+    GLint maxTextureUnits = 0;
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+    if(maxTextureUnits > quadTextureUnits){
+        fontTextureUnit = quadTextureUnits;
+    }else{
+        fontTextureUnit = maxTextureUnits > 0 ? maxTextureUnits - 1 : 0;
+        std::cout << "Warning: Only " << maxTextureUnits << " texture units are available, fonts share texture unit " << fontTextureUnit << " with the quad textures!\n";
+    }
+
     // set expplicit texture slot in shader
     textShader.Use();
     int uniformLoc = glGetUniformLocation(textShader.getID(), "text");
-    glUniform1i(uniformLoc, 0);
+    glUniform1i(uniformLoc, fontTextureUnit);
 
     // configure VAO/VBO for positioning and texturing
     initTextRenderingData();
@@ -120,8 +130,14 @@ void TextRenderer::FlushText(){
     // ensure shader usage
     textShader.Use();
 
-    // rebind font textures
-    TextureManager::BindFontTextures();
+    // bind the batch's font to its own unit, the quad textures stay bound
+    if(GLAD_GL_VERSION_4_5){
+        glBindTextureUnit(fontTextureUnit, characterSet->texID);
+    }else{
+        glActiveTexture(GL_TEXTURE0 + fontTextureUnit);
+        glBindTexture(GL_TEXTURE_2D, characterSet->texID);
+        glActiveTexture(GL_TEXTURE0);
+    }
     
     // draw the character/s
     glBindVertexArray(VAO);
@@ -132,9 +148,6 @@ void TextRenderer::FlushText(){
     
     // reset vertex count
     charVertexCount = 0;
-    
-    // rebind non-font textures
-    TextureManager::BindTextures();
 }
 
 void TextRenderer::createCharacter(CharacterSet& set, std::string text, glm::vec3 position, float rotation, float size, glm::vec4 color){     
@@ -143,6 +156,15 @@ void TextRenderer::createCharacter(CharacterSet& set, std::string text, glm::vec
     
     // local storage of the position for each glyph
     glm::vec3 localPosition = position;
+
+    // a batch only holds a single font, render the previous font's characters first
+    if(characterSet != &set){
+        if(charVertexCount > 0){
+            FlushText();
+            beginCharacterBatch();
+        }
+        characterSet = &set;
+    }
     
     for(char ch : text){
         // cehck if the charecter glyph is in the font atlas
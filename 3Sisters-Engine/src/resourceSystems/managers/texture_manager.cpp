@@ -1,6 +1,7 @@
 #include "resourceSystems/resource_types.hpp"
 #include <resourceSystems/managers/texture_manager.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <array>
 #include <iostream>
@@ -17,7 +18,12 @@
 std::map<std::string, Texture>                                              TextureManager::Textures;
 std::map<std::string, CharacterSet>                                         TextureManager::Fonts;
 std::map<std::string, SubTexture>                                           TextureManager::SubTextures;
+std::map<std::string, TextureArray>                                         TextureManager::TextureArrays;
+std::map<std::string, int>                                                  TextureManager::TextureLayers;
 std::vector<unsigned int>                                                   TextureManager::texIDList;
+std::vector<GLuint64>                                                       TextureManager::texHandleList;
+unsigned int                                                                TextureManager::texHandleBuffer = 0;
+bool                                                                        TextureManager::isBindless = false;
 bool                                                                        TextureManager::doesWhiteTexExist = false;
 bool                                                                        TextureManager::isAutoClearSet = false;
 
@@ -61,8 +67,8 @@ Texture& TextureManager::LoadTexture(const char *file, std::string name, bool is
     // add texture ID to list
     texIDList.push_back(Textures[name].GetID());
 
-    //? bind the textures
-    BindTextures();
+    //? bind only the new texture, the others are still bound
+    bindTexture(texIDList.size() - 1);
 
     return Textures[name];
 }
@@ -189,8 +195,8 @@ void TextureManager::GenerateWhiteTexture(){
         // add texture ID to list
         texIDList.push_back(Textures["default"].GetID());
 
-        //? bind the textures
-        BindTextures();
+        //? bind only the new texture, the others are still bound
+        bindTexture(texIDList.size() - 1);
         
         // turn off ability to call this function again
         doesWhiteTexExist = true;
@@ -200,6 +206,94 @@ void TextureManager::GenerateWhiteTexture(){
     }
 }
 
+TextureArray& TextureManager::CreateTextureArray(std::string name, unsigned int width, unsigned int height, unsigned int layers, bool isLinear){
+    // set up automatic clear()
+    setUpAutoClear();
+
+    // create texture array object
+    TextureArray textureArray;
+
+    // set filter
+    if(isLinear){
+        textureArray.SetTextureFilterMin(GL_LINEAR);
+        textureArray.SetTextureFilterMax(GL_LINEAR);
+    }
+
+    // generate the empty layers
+    textureArray.Generate(width, height, layers);
+
+    // store texture array
+    TextureArrays[name] = textureArray;
+    return TextureArrays[name];
+}
+
+int TextureManager::LoadTextureLayer(const char* file, std::string name, std::string arrayName){
+    //? check if the texture array exists
+    auto it = TextureArrays.find(arrayName);
+    if(it == TextureArrays.end()){
+        std::cout << "ERROR: Couldn't find texture array: " << arrayName << ", in storage!" << std::endl;
+        return -1;
+    }
+    TextureArray& textureArray = it->second;
+
+    // load image, always as RGBA so every layer shares a format
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 4);
+    // check file if it has been found
+    if(!data){
+        std::cout << "ERROR: Failed to load texture file: " << file << " !\n";
+        std::cout << "ERROR: " << stbi_failure_reason() << "\n";
+        return -1;
+    }
+
+    //? check if the image fits the layers
+    if((unsigned int)width != textureArray.GetWidth() || (unsigned int)height != textureArray.GetHeight()){
+        std::cout << "ERROR: Texture: " << file << " is " << width << "x" << height << ", but the layers of texture array: " << arrayName << " are " << textureArray.GetWidth() << "x" << textureArray.GetHeight() << "!\n";
+        stbi_image_free(data);
+        return -1;
+    }
+
+    // fill the next free layer
+    int layer = textureArray.AddLayer(data);
+    stbi_image_free(data);
+
+    if(layer >= 0){
+        TextureLayers[name] = layer;
+    }
+    return layer;
+}
+
+bool TextureManager::EnableBindlessTextures(){
+    if(isBindless){
+        return true;
+    }
+
+    //? check if bindless textures are supported
+    if(!GLAD_GL_ARB_bindless_texture || !GLAD_GL_VERSION_4_5){
+        std::cout << "Warning: Bindless textures aren't supported, texture units will be used instead!\n";
+        return false;
+    }
+
+    // create the storage buffer of the handles
+    glCreateBuffers(1, &texHandleBuffer);
+
+    // from now on new textures get a handle instead of a texture unit
+    isBindless = true;
+    for(int i = 0; i < (int)texIDList.size(); i++){
+        addTextureHandle(i);
+    }
+
+    // upload every handle at once, this also binds the buffer when no texture was loaded yet
+    uploadTextureHandles();
+
+    return true;
+}
+
+bool TextureManager::IsBindless(){
+    return isBindless;
+}
+
 int TextureManager::GetTextureIndex(std::string name){
 
     //*NOTE: The check is used to prevent using this function when no texture was binded to OpenGL
@@ -229,6 +323,19 @@ CharacterSet& TextureManager::GetFontTexture(std::string name){
     return Fonts[name];
 }
 
+TextureArray& TextureManager::GetTextureArray(std::string name){
+    return TextureArrays[name];
+}
+
+int TextureManager::GetTextureLayer(std::string name){
+    auto it = TextureLayers.find(name);
+    if(it == TextureLayers.end()){
+        std::cout << "ERROR: Couldn't find texture layer: " << name << ", in storage!" << std::endl;
+        return -1;
+    }
+    return it->second;
+}
+
 std::array<glm::vec2, 4>& TextureManager::GetSubTexture(std::string name){
     return SubTextures[name].TexCoords;
 }
@@ -276,24 +383,30 @@ bool TextureManager::BindTextures(){
         return false;
     }
 
-    // bind all the textures from first to last
-    for(int i = 0; i < texIDList.size(); i++){
-        // check opengl version
-        if(GLAD_GL_VERSION_4_5){
-            // call to bind texture by their ID to an index 
-            glBindTextureUnit(i, texIDList[i]);
-        }else{
-            //? this may cause issues with multiple textures
-            // call to bind texture by their ID to an index
-            glActiveTexture(GL_TEXTURE0 + i);;
-            glBindTexture(GL_TEXTURE_2D, texIDList[i]);
-        }
+    // bindless textures stay resident, only the storage buffer of their handles has to be bound
+    if(isBindless){
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, texHandleBuffer);
+        return true;
+    }
+
+    // check opengl version, bind every texture with a single call
+    if(GLAD_GL_VERSION_4_4){
+        glBindTextures(0, texIDList.size(), texIDList.data());
+
         // check OpenGL errors
         int errorCode = glGetError();
         if(errorCode != GL_NO_ERROR){
             std::cout << "ERROR: An error occured during binding texures, ERROR Code: " << errorCode << std::endl;
-            std::cout << "ERROR: Texture ID: " << texIDList[i] << " | Failed to be binded to index: " << i << "\n";
-            return false; 
+            std::cout << "ERROR: " << texIDList.size() << " textures failed to be binded, there may not be enough texture units\n";
+            return false;
+        }
+        return true;
+    }
+
+    // bind all the textures from first to last
+    for(int i = 0; i < texIDList.size(); i++){
+        if(!bindTexture(i)){
+            return false;
         }
     }
 
@@ -302,6 +415,50 @@ bool TextureManager::BindTextures(){
     return true;
 }
 
+bool TextureManager::bindTexture(int index){
+    // add a handle instead of binding to a texture unit
+    if(isBindless){
+        addTextureHandle(index);
+        uploadTextureHandles();
+        return true;
+    }
+
+    // check opengl version
+    if(GLAD_GL_VERSION_4_5){
+        // call to bind texture by their ID to an index 
+        glBindTextureUnit(index, texIDList[index]);
+    }else{
+        //? this may cause issues with multiple textures
+        // call to bind texture by their ID to an index
+        glActiveTexture(GL_TEXTURE0 + index);
+        glBindTexture(GL_TEXTURE_2D, texIDList[index]);
+    }
+    // check OpenGL errors
+    int errorCode = glGetError();
+    if(errorCode != GL_NO_ERROR){
+        std::cout << "ERROR: An error occured during binding texures, ERROR Code: " << errorCode << std::endl;
+        std::cout << "ERROR: Texture ID: " << texIDList[index] << " | Failed to be binded to index: " << index << "\n";
+        return false; 
+    }
+    return true;
+}
+
+void TextureManager::addTextureHandle(int index){
+    GLuint64 handle = glGetTextureHandleARB(texIDList[index]);
+    glMakeTextureHandleResidentARB(handle);
+
+    if(index >= (int)texHandleList.size()){
+        texHandleList.resize(index + 1, 0);
+    }
+    texHandleList[index] = handle;
+}
+
+void TextureManager::uploadTextureHandles(){
+    // the buffer is re-specified, handles only change when a texture is loaded
+    glNamedBufferData(texHandleBuffer, sizeof(GLuint64) * std::max<std::size_t>(texHandleList.size(), 1), texHandleList.empty() ? nullptr : texHandleList.data(), GL_STATIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, texHandleBuffer);
+}
+
 bool TextureManager::BindFontTextures(){
     // check if the font list is not empty
     if(Fonts.empty()){
@@ -469,6 +626,23 @@ uint8_t* TextureManager::loadFontFromFile(CharacterSet* chars, const char* file,
 }
 
 void TextureManager::clear(){
+    // release the bindless handles before their textures
+    for(GLuint64 handle : texHandleList){
+        if(handle != 0){
+            glMakeTextureHandleNonResidentARB(handle);
+        }
+    }
+    if(texHandleBuffer != 0){
+        glDeleteBuffers(1, &texHandleBuffer);
+    }
+    // textures loaded afterwards must not use the deleted buffer or the released handles
+    texHandleList.clear();
+    texHandleBuffer = 0;
+    isBindless = false;
+    // (properly) delete all texture arrays
+    for(auto iter : TextureArrays){
+        iter.second.DeleteTexture();
+    }
     // (properly) delete all textures
     for (auto iter : Textures)
         glDeleteTextures(1, &iter.second.GetID());
@@ -0,0 +1,120 @@
+#include <resourceSystems/resource_texture_array.hpp>
+
+// include print
+#include <iostream>
+
+TextureArray::TextureArray() : ID(0), Width(0), Height(0), Layers(0), Used_Layers(0), Internal_Format(GL_RGBA8), Image_Format(GL_RGBA),
+Wrap_S(GL_REPEAT), Wrap_T(GL_REPEAT), Filter_Min(GL_NEAREST), Filter_Max(GL_NEAREST)
+{}
+
+void TextureArray::Generate(unsigned int width, unsigned int height, unsigned int layers){
+    this->Width = width;
+    this->Height = height;
+    this->Layers = layers;
+    this->Used_Layers = 0;
+
+    // check opengl version
+    if(GLAD_GL_VERSION_4_5){
+        // generate ID
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &this->ID);
+
+        glTextureStorage3D(ID, 1, this->Internal_Format, width, height, layers);
+
+        // set Texture wrap and filter modes
+        glTextureParameteri(ID, GL_TEXTURE_WRAP_S, this->Wrap_S);
+        glTextureParameteri(ID, GL_TEXTURE_WRAP_T, this->Wrap_T);
+        glTextureParameteri(ID, GL_TEXTURE_MIN_FILTER, this->Filter_Min);
+        glTextureParameteri(ID, GL_TEXTURE_MAG_FILTER, this->Filter_Max);
+    }else{
+        // generate ID
+        glGenTextures(1, &this->ID);
+        // bind Texture
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+        // set Texture wrap and filter modes
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, this->Wrap_S);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, this->Wrap_T);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, this->Filter_Min);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, this->Filter_Max);
+
+        // allocate every layer, they are filled by AddLayer()
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, this->Internal_Format, width, height, layers, 0, this->Image_Format, GL_UNSIGNED_BYTE, nullptr);
+
+        // unbind the texture
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    // check OpenGL errors
+    int errorCode = glGetError();
+    if(errorCode != GL_NO_ERROR){
+        std::cout << "ERROR: An error occured during creation of texture array, ERROR Code: " << errorCode << std::endl;
+    }
+}
+
+int TextureArray::AddLayer(unsigned char* data){
+    //? check if every layer is in use
+    if(Used_Layers >= Layers){
+        //! Display error
+        std::cout << "ERROR: Texture array is full, it only has " << Layers << " layers!\n";
+        return -1;
+    }
+
+    // check opengl version
+    if(GLAD_GL_VERSION_4_5){
+        glTextureSubImage3D(ID, 0, 0, 0, Used_Layers, Width, Height, 1, this->Image_Format, GL_UNSIGNED_BYTE, data);
+    }else{
+        glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, Used_Layers, Width, Height, 1, this->Image_Format, GL_UNSIGNED_BYTE, data);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    return Used_Layers++;
+}
+
+void TextureArray::DeleteTexture(){
+    // delete the texture array
+    glDeleteTextures(1, &ID);
+}
+
+void TextureArray::SetTextureInternalFormat(unsigned int format){
+    Internal_Format = format;
+}
+
+void TextureArray::SetTextureImageFormat(unsigned int format){
+    Image_Format = format;
+}
+
+void TextureArray::SetTextureFilterMin(unsigned int filter){
+    Filter_Min = filter;
+}
+
+void TextureArray::SetTextureFilterMax(unsigned int filter){
+    Filter_Max = filter;
+}
+
+void TextureArray::SetWrapS(unsigned int mode){
+    Wrap_S = mode;
+}
+
+void TextureArray::SetWrapT(unsigned int mode){
+    Wrap_T = mode;
+}
+
+unsigned int& TextureArray::GetID(){
+    return this->ID;
+}
+
+unsigned int TextureArray::GetWidth(){
+    return Width;
+}
+
+unsigned int TextureArray::GetHeight(){
+    return Height;
+}
+
+unsigned int TextureArray::GetLayers(){
+    return Layers;
+}
+
+unsigned int TextureArray::GetUsedLayers(){
+    return Used_Layers;
+}
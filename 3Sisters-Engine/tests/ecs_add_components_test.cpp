@@ -0,0 +1,64 @@
+#include <ecs/ecs.hpp>
+
+// include standard library
+#include <cstdio>
+#include <cstdlib>
+
+/* Checks that adding several components to an entity that already
+contains one of them skips only that component, so the signature,
+systems, and observers agree with what is actually stored. Runs with
+the storage option given as the first argument, 's' (sparse) or 'a' (archetype).
+*/
+
+// stop the test when a condition doesn't hold
+#define CHECK(condition) if(!(condition)){ std::printf("FAILED: %s (line %d)\n", #condition, __LINE__); return EXIT_FAILURE; }
+
+struct Position{
+    float x, y;
+};
+
+struct Velocity{
+    float x, y;
+};
+
+// system requiring a velocity, used to check the entity's membership
+class MoveSystem : public System{};
+
+int main(int argc, char** argv){
+    char storageOption = argc > 1 ? argv[1][0] : 's';
+    ECS::Init('d', storageOption);
+    ECS::RegisterComponent<Position>();
+    ECS::RegisterComponent<Velocity>();
+
+    std::shared_ptr<MoveSystem> moveSystem = ECS::RegisterSystem<MoveSystem>();
+    ECS::SetSystemSignature<MoveSystem>(ECS::GetComponentSignature<Velocity>());
+
+    int positionsAdded = 0;
+    int velocitiesAdded = 0;
+    ECS::OnAdd<Position>([&](Entity, Position&){ positionsAdded++; });
+    ECS::OnAdd<Velocity>([&](Entity, Velocity&){ velocitiesAdded++; });
+
+    Entity entity = ECS::CreateEntity();
+    ECS::AddComponent(entity, Position{1.0f, 0.0f});
+    CHECK(positionsAdded == 1);
+
+    // the existing position is kept and only the velocity is added
+    ECS::AddComponent(entity, Position{2.0f, 0.0f}, Velocity{3.0f, 0.0f});
+    CHECK(ECS::CheckComponent<Position>(entity));
+    CHECK(ECS::GetComponent<Position>(entity).x == 1.0f);
+    CHECK(ECS::CheckComponent<Velocity>(entity));
+    CHECK(ECS::GetComponent<Velocity>(entity).x == 3.0f);
+    CHECK(moveSystem->entities.Contains(entity));
+    CHECK(positionsAdded == 1);
+    CHECK(velocitiesAdded == 1);
+
+    // adding only components the entity already contains changes nothing
+    ECS::AddComponent(entity, Position{4.0f, 0.0f}, Velocity{5.0f, 0.0f});
+    CHECK(ECS::GetComponent<Position>(entity).x == 1.0f);
+    CHECK(ECS::GetComponent<Velocity>(entity).x == 3.0f);
+    CHECK(positionsAdded == 1);
+    CHECK(velocitiesAdded == 1);
+
+    std::printf("ecs add components test passed (%c)\n", storageOption);
+    return EXIT_SUCCESS;
+}
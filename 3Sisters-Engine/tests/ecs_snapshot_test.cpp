@@ -0,0 +1,209 @@
+#include <ecs/ecs.hpp>
+
+// include standard library
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/* Checks that a world survives a round trip through a snapshot,
+including destroyed slots and tags, and that corrupt snapshots are
+rejected without touching the current world. Runs with the storage
+option given as the first argument, 's' (sparse) or 'a' (archetype).
+*/
+
+// stop the test when a condition doesn't hold
+#define CHECK(condition) if(!(condition)){ std::printf("FAILED: %s (line %d)\n", #condition, __LINE__); return EXIT_FAILURE; }
+
+// both have the same size and the same length of name, so a pool of one can be renamed to the other
+struct Position{
+    float x, y;
+};
+
+struct Velocity{
+    float x, y;
+};
+
+struct Frozen{};
+
+// byte offsets of a component pool within a snapshot, follows the layout written by ECS::SaveSnapshot()
+struct PoolLayout{
+    std::size_t header;
+    std::size_t name;
+    std::size_t entities;
+    std::size_t components;
+};
+
+static std::size_t alignUp(std::size_t value){
+    return (value + 63) / 64 * 64;
+}
+
+static std::vector<PoolLayout> findPools(const std::vector<std::byte>& snapshot){
+    std::uint32_t poolCount;
+    std::uint64_t slotCount;
+    std::memcpy(&poolCount, snapshot.data() + 12, sizeof(poolCount));
+    std::memcpy(&slotCount, snapshot.data() + 16, sizeof(slotCount));
+
+    std::vector<PoolLayout> pools;
+    std::size_t offset = 64 + slotCount * sizeof(Entity);
+    for(std::uint32_t i = 0; i < poolCount; i++){
+        std::uint32_t nameLength, size;
+        std::uint64_t count;
+        std::memcpy(&nameLength, snapshot.data() + offset, sizeof(nameLength));
+        std::memcpy(&size, snapshot.data() + offset + 4, sizeof(size));
+        std::memcpy(&count, snapshot.data() + offset + 16, sizeof(count));
+
+        PoolLayout pool;
+        pool.header = offset;
+        pool.name = offset + 24;
+        pool.entities = alignUp(pool.name + nameLength);
+        pool.components = alignUp(pool.entities + count * sizeof(Entity));
+        pools.push_back(pool);
+
+        offset = pool.components + count * size;
+    }
+    return pools;
+}
+
+// check if the world still holds what it had before a rejected load
+static bool unchanged(Entity kept){
+    int count = 0;
+    for(auto [entity, position] : ECS::View<Position>()){
+        if(entity != kept || position.x != 42.0f){
+            return false;
+        }
+        count++;
+    }
+    return count == 1;
+}
+
+int main(int argc, char** argv){
+    char storageOption = argc > 1 ? argv[1][0] : 's';
+    ECS::Init('d', storageOption);
+    ECS::RegisterComponent<Position>();
+    ECS::RegisterComponent<Velocity>();
+    ECS::RegisterComponent<Frozen>();
+
+    // entities spread over a few archetypes, with destroyed slots in between
+    std::vector<Entity> entities;
+    for(int i = 0; i < 300; i++){
+        Entity entity = ECS::CreateEntity();
+        ECS::AddComponent(entity, Position{(float)i, (float)-i});
+        if(i % 2 == 0){
+            ECS::AddComponent(entity, Velocity{(float)i * 2.0f, 1.0f});
+        }
+        if(i % 3 == 0){
+            ECS::AddComponent(entity, Frozen{});
+        }
+        entities.push_back(entity);
+    }
+    for(int i = 0; i < 300; i += 7){
+        ECS::DestroyEntity(entities[i]);
+    }
+    // removing a component reorders rows, so pools aren't in creation order
+    ECS::RemoveComponent<Velocity>(entities[10]);
+
+    std::vector<std::byte> snapshot;
+    CHECK(ECS::SaveSnapshot(snapshot));
+
+    // replace the world with something else, then load the snapshot back
+    std::vector<Entity> living;
+    for(int i = 0; i < 300; i++){
+        if(i % 7 != 0){
+            living.push_back(entities[i]);
+        }
+    }
+    ECS::DestroyEntities(living);
+    Entity kept = ECS::CreateEntity();
+    ECS::AddComponent(kept, Position{42.0f, 0.0f});
+
+    CHECK(ECS::LoadSnapshot(snapshot.data(), snapshot.size()));
+    for(int i = 0; i < 300; i++){
+        Entity entity = entities[i];
+        if(i % 7 == 0){
+            CHECK(!ECS::IsValid(entity));
+            continue;
+        }
+
+        CHECK(ECS::IsValid(entity));
+        CHECK(ECS::GetComponent<Position>(entity).x == (float)i && ECS::GetComponent<Position>(entity).y == (float)-i);
+        CHECK(ECS::CheckComponent<Velocity>(entity) == (i % 2 == 0 && i != 10));
+        if(ECS::CheckComponent<Velocity>(entity)){
+            CHECK(ECS::GetComponent<Velocity>(entity).x == (float)i * 2.0f);
+        }
+        CHECK(ECS::CheckComponent<Frozen>(entity) == (i % 3 == 0));
+    }
+
+    int count = 0;
+    for(auto [entity, position] : ECS::View<Position>()){
+        CHECK(ECS::IsValid(entity));
+        count++;
+    }
+    CHECK(count == 300 - 43);
+
+    // destroyed slots are reused with a newer generation
+    Entity reused = ECS::CreateEntity();
+    CHECK(GetEntityIndex(reused) % 7 == 0 && reused != entities[GetEntityIndex(reused)]);
+
+    // every corrupt snapshot has to be rejected without touching the world
+    living.push_back(reused);
+    ECS::DestroyEntities(living);
+    kept = ECS::CreateEntity();
+    ECS::AddComponent(kept, Position{42.0f, 0.0f});
+
+    std::vector<PoolLayout> pools = findPools(snapshot);
+    CHECK(pools.size() == 3);
+
+    // an entity listed twice within one pool
+    std::vector<std::byte> corrupt = snapshot;
+    std::memcpy(corrupt.data() + pools[0].entities + sizeof(Entity), corrupt.data() + pools[0].entities, sizeof(Entity));
+    CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+    CHECK(unchanged(kept));
+
+    // two pools of the same component
+    corrupt = snapshot;
+    std::memcpy(corrupt.data() + pools[1].name, corrupt.data() + pools[0].name, std::strlen(typeid(Position).name()));
+    CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+    CHECK(unchanged(kept));
+
+    // alignment that isn't a power of two or is larger than a blob's alignment
+    for(std::uint32_t alignment : {0u, 3u, 128u}){
+        corrupt = snapshot;
+        std::memcpy(corrupt.data() + pools[0].header + 8, &alignment, sizeof(alignment));
+        CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+        CHECK(unchanged(kept));
+    }
+
+    // amounts that overflow when multiplied by the size of an element
+    std::uint64_t huge = ~0ull / sizeof(Entity) + 2;
+    corrupt = snapshot;
+    std::memcpy(corrupt.data() + pools[0].header + 16, &huge, sizeof(huge));
+    CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+    CHECK(unchanged(kept));
+
+    corrupt = snapshot;
+    std::memcpy(corrupt.data() + 16, &huge, sizeof(huge));
+    CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+    CHECK(unchanged(kept));
+
+    // a free list that starts at a living entity
+    std::uint64_t freeList = GetEntityIndex(entities[1]);
+    corrupt = snapshot;
+    std::memcpy(corrupt.data() + 24, &freeList, sizeof(freeList));
+    CHECK(!ECS::LoadSnapshot(corrupt.data(), corrupt.size()));
+    CHECK(unchanged(kept));
+
+    // a snapshot cut short
+    CHECK(!ECS::LoadSnapshot(snapshot.data(), snapshot.size() - 1));
+    CHECK(unchanged(kept));
+
+    // blobs that aren't aligned in memory are still loaded
+    std::vector<std::byte> shifted(snapshot.size() + 1);
+    std::memcpy(shifted.data() + 1, snapshot.data(), snapshot.size());
+    CHECK(ECS::LoadSnapshot(shifted.data() + 1, snapshot.size()));
+    CHECK(ECS::GetComponent<Position>(entities[1]).x == 1.0f);
+
+    std::printf("ecs snapshot test passed (%c)\n", storageOption);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#include <ecs/ecs.hpp>
+
+// include standard library
+#include <cstdio>
+#include <cstdlib>
+
+/* Checks that handles of destroyed entities are rejected after
+their slot is reused by a new entity, so they can't add, remove,
+or read the new entity's components, even once the slot's
+generations are used up. Runs with the storage option
+given as the first argument, 's' (sparse) or 'a' (archetype).
+*/
+
+// stop the test when a condition doesn't hold
+#define CHECK(condition) if(!(condition)){ std::printf("FAILED: %s (line %d)\n", #condition, __LINE__); return EXIT_FAILURE; }
+
+struct Position{
+    float x, y;
+};
+
+struct Velocity{
+    float x, y;
+};
+
+int main(int argc, char** argv){
+    char storageOption = argc > 1 ? argv[1][0] : 's';
+    ECS::Init('d', storageOption);
+    ECS::RegisterComponent<Position>();
+    ECS::RegisterComponent<Velocity>();
+
+    // destroy an entity so its slot is reused with a new generation
+    Entity a = ECS::CreateEntity();
+    Entity b = ECS::CreateEntity();
+    ECS::AddComponent(a, Position{1.0f, 0.0f});
+    ECS::DestroyEntity(b);
+
+    Entity c = ECS::CreateEntity();
+    CHECK(GetEntityIndex(c) == GetEntityIndex(b));
+    CHECK(c != b);
+    ECS::AddComponent(c, Position{2.0f, 0.0f});
+
+    // the stale handle must not reach the new entity's components
+    ECS::AddComponent(b, Position{99.0f, 0.0f});
+    ECS::AddComponent(b, Velocity{1.0f, 1.0f});
+    CHECK(ECS::EmplaceComponent<Velocity>(b, 1.0f, 1.0f) == nullptr);
+    CHECK(ECS::CheckComponent<Position>(c));
+    CHECK(!ECS::CheckComponent<Velocity>(c));
+    CHECK(!ECS::CheckComponent<Position>(b));
+    CHECK(ECS::GetComponent<Position>(c).x == 2.0f);
+
+    ECS::RemoveComponent<Position>(b);
+    CHECK(ECS::CheckComponent<Position>(c));
+    CHECK(ECS::GetComponent<Position>(c).x == 2.0f);
+
+    ECS::Patch<Position>(b, [](Position& position){ position.x = 99.0f; });
+    CHECK(ECS::GetComponent<Position>(c).x == 2.0f);
+
+    // views only yield living handles with their own components
+    int count = 0;
+    for(auto [entity, position] : ECS::View<Position>()){
+        CHECK(ECS::IsValid(entity));
+        CHECK(entity == a || entity == c);
+        CHECK(position.x == (entity == a ? 1.0f : 2.0f));
+        count++;
+    }
+    CHECK(count == 2);
+
+    // reading through the stale handle throws
+    bool thrown = false;
+    try{
+        ECS::GetComponent<Position>(b);
+    }catch(const std::invalid_argument&){
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // a slot whose generations are used up is retired, so a cached handle never becomes valid again
+    if(ENTITY_GENERATION_MASK < 0xffff){
+        Entity first = ECS::CreateEntity();
+        Entity recycled = first;
+        for(Entity generation = 0; generation <= ENTITY_GENERATION_MASK + 1; generation++){
+            ECS::DestroyEntity(recycled);
+            recycled = ECS::CreateEntity();
+            CHECK(recycled != first);
+            CHECK(!ECS::IsValid(first));
+        }
+        CHECK(GetEntityIndex(recycled) != GetEntityIndex(first));
+    }
+
+    std::printf("ecs stale handle test passed (%c)\n", storageOption);
+    return EXIT_SUCCESS;
+}